@@ -1,7 +1,7 @@
 //////////////////////////////////////////////////////////////////////
 // Persistance.cpp	:	Provides Interface to Read (or) Write XML	//
 //						Document to (or) from Disk.					//
-// Version			:	2.0											//
+// Version			:	2.4											//
 // -----------------------------------------------------------------//
 // Copyright  Venkata Chekuri, 2016								//
 // All rights granted provided that this notice is retained.		//
@@ -16,6 +16,102 @@
 
 #include "Persistance.h"
 
+#include <mutex>
+#include <algorithm>
+#include <thread>
+
+namespace {
+	/** Files [next, end) of a Persistance::ToXDocs Batch Which One Worker
+	  * Still Has to Load. The Worker Takes Them From the Front; Once its
+	  * Own Range is Empty it Steals the Back Half of Another's.
+	  *
+	  * Dependant Class(es) or Structure(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	struct LoadRange {
+		LoadRange() : next(0), end(0) {}
+
+		std::mutex lock;
+		size_t next;
+		size_t end;
+	};
+
+	/** Function to Take the Next File From the Front of a Range. Returns
+	  * False if the Range is Empty.
+	  *
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	bool TakeFront(LoadRange & range, size_t & index) {
+		std::lock_guard<std::mutex> guard(range.lock);
+		if (range.next == range.end)
+			return false;
+		index = range.next++;
+		return true;
+	}
+
+	/** Function to Move the Back Half of the First Non Empty Range (Looking
+	  * From the Thief's Neighbour Onwards) Into the Thief's Empty Range.
+	  * Returns False if There is Nothing Left to Steal. Only One Range is
+	  * Locked at a Time.
+	  *
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	bool StealHalf(std::vector<LoadRange> & ranges, size_t thief) {
+		for (size_t i = 1; i < ranges.size(); ++i) {
+			LoadRange & victim = ranges[(thief + i) % ranges.size()];
+			size_t first, last;
+			{
+				std::lock_guard<std::mutex> guard(victim.lock);
+				size_t left = victim.end - victim.next;
+				if (left == 0)
+					continue;
+				last = victim.end;
+				first = last - (left + 1) / 2;
+				victim.end = first;
+			}
+			std::lock_guard<std::mutex> guard(ranges[thief].lock);
+			ranges[thief].next = first;
+			ranges[thief].end = last;
+			return true;
+		}
+		return false;
+	}
+
+	/** Function Run by Each Worker of Persistance::ToXDocs : Loads the Files
+	  * of its Own Range, Then Steals Until Every File is Loaded. One Toker
+	  * (With its Buffers and Lookup Tables) is Used For All of Them.
+	  *
+	  * Dependant Function(s) - TakeFront, StealHalf, Toker::Compute,
+	  *							Toker::GetError
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void LoadFiles(std::vector<LoadRange> * ranges, size_t self, std::vector<LoadResult> * results, bool magicQuotes) {
+		XMLScanner::Toker toker(false, magicQuotes);
+		size_t index;
+		do {
+			while (TakeFront((*ranges)[self], index)) {
+				LoadResult & result = (*results)[index];
+				result.xDoc = toker.Compute(result.path);
+				if (result.xDoc == nullptr) {
+					result.error = toker.GetError().message;
+					if (result.error.empty())
+						result.error = "Can't Read " + result.path;
+				}
+			}
+		} while (StealHalf(*ranges, self));
+	}
+}
+
 /** Constructor for Persistance Package/Class.
   * By Default XML Protection is Turned Off.
   *
@@ -131,8 +227,11 @@ void Persistance::generateIndent(std::string & str, int indent) {
   * XML File Using XML Document. This Generated String Usually will be Written to
   * Disk.
   *
-  * Dependant Function(s) - Persistance::MagicQuoteProtection, Persistance::generateIndent
+  * Dependant Function(s) - Persistance::MagicQuoteProtection, Persistance::generateIndent,
+  *							Node::GetValue, Node::GetAttributes
   *
+  * Ver : 1.1
+  *		- Reads Value & Attributes Through GetValue & GetAttributes (Lazy Values).
   * Ver : 1.0
   *		- First Release.
   */
@@ -141,7 +240,7 @@ void Persistance::PreviewToDiskHelper(std::string & str, Node * _node, int inden
 		return;
 
 	std::string tag = _node->tag;
-	std::string val = _node->value;
+	std::string val = _node->GetValue();
 	
 	if (MagicQuoteProtection) {
 		XMLProtectionMagicQuotes(tag);
@@ -155,7 +254,7 @@ void Persistance::PreviewToDiskHelper(std::string & str, Node * _node, int inden
 	str.append("<" + tag);
 	
 	if (!_node->attributes.empty()) {
-		for (std::pair<std::string, std::string> pr : _node->attributes) {
+		for (std::pair<std::string, std::string> pr : _node->GetAttributes()) {
 			if (MagicQuoteProtection) {
 				XMLProtectionMagicQuotes(pr.first);
 				XMLProtectionMagicQuotes(pr.second);
@@ -209,9 +308,15 @@ void Persistance::XMLProtectionMagicQuotes(std::string & str) {
 }
 
 /** Method to Read XML File and Generate XML Document Structure using it.
+  * The File May be gzip / zstd Compressed (No Temporary File is Needed;
+  * Needs a Build With XML_WITH_ZLIB / XML_WITH_ZSTD).
   *
   * Dependant Function(s) - Toker::Compute, Toker::Toker
   *
+  * Ver : 2.2
+  *		- Toker is No Longer Leaked.
+  * Ver : 2.1
+  *		- Compressed Files are Read Directly.
   * Ver : 2.0
   *		- Updated Toker to be a Pointer as Toker Constructor Has Been Updated
   *		  to Support MagicQuoteProtection & VERBOSE Mode.
@@ -220,9 +325,64 @@ void Persistance::XMLProtectionMagicQuotes(std::string & str) {
   *		- First Release.
   */
 XMLDocument * Persistance::ToXDoc() {
-	using namespace XMLScanner;
-	Toker * toker = new Toker(VERBOSE, MagicQuoteProtection);
-	return toker->Compute(filePath);
+	XMLScanner::Toker toker(VERBOSE, MagicQuoteProtection);
+	return toker.Compute(filePath);
+}
+
+/** Method to Generate XML Document Structure From XML Text Which is Already
+  * in Memory (No File Involved). The Text is Read In Place, Not Copied.
+  *
+  * Dependant Function(s) - Toker::Compute, Toker::Toker
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+XMLDocument * Persistance::FromBuffer(const char * data, size_t length) {
+	XMLScanner::Toker toker(VERBOSE, MagicQuoteProtection);
+	return toker.Compute(data, length);
+}
+
+/** Method to Generate XML Document Structures From Many XML Files at Once
+  * (the Path Set With SetPath is Not Used). The Files are Split Into
+  * Contiguous Ranges, One Per Worker Thread; a Worker Which Finishes Early
+  * Steals Half of the Files Left in Another's Range. Each Worker Reuses One
+  * Toker For All the Files it Loads. threads = 0 Uses One Thread Per
+  * Hardware Thread (Never More Than There are Files); the Calling Thread is
+  * One of Them.
+  *
+  * The Results are in the Same Order as paths. A File Which Cannot be Read
+  * Has a nullptr xDoc and Says Why in error; the Caller Owns the Others.
+  *
+  * Dependant Function(s) - LoadFiles, Toker::Compute
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<LoadResult> Persistance::ToXDocs(const std::vector<std::string> & paths, unsigned threads) {
+	std::vector<LoadResult> results(paths.size());
+	for (size_t i = 0; i < paths.size(); ++i)
+		results[i].path = paths[i];
+	if (paths.empty())
+		return results;
+	if (threads == 0)
+		threads = std::max(std::thread::hardware_concurrency(), 1u);
+	size_t workers = std::min<size_t>(threads, paths.size());
+
+	std::vector<LoadRange> ranges(workers);
+	for (size_t i = 0; i < workers; ++i) {
+		ranges[i].next = paths.size() * i / workers;
+		ranges[i].end = paths.size() * (i + 1) / workers;
+	}
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Loading " << paths.size() << " Files on " << workers << " Threads";
+
+	std::vector<std::thread> pool;
+	for (size_t i = 1; i < workers; ++i)
+		pool.push_back(std::thread(LoadFiles, &ranges, i, &results, MagicQuoteProtection));
+	LoadFiles(&ranges, 0, &results, MagicQuoteProtection);
+	for (std::thread & worker : pool)
+		worker.join();
+	return results;
 }
 
 /** Method to Set the VERBOSE Variable.
@@ -307,6 +467,10 @@ XMLDocument * CreateXDoc() {
   *							Persistance::ToDisk, StringHelper::Title, Timer::Begin, Timer::End, 
   *							Timer::TimeForTask
   *
+  * Ver : 2.2
+  *		- Added Read Many XML Files (Batch) Task.
+  * Ver : 2.1
+  *		- Added Read From XML Preview (In Memory) Task.
   * Ver : 2.0
   *		- Updated Read From XML Task (Since ToXDoc Function was Changed).
   * Ver : 1.0
@@ -346,6 +510,29 @@ int main() {
 		xDocNew->ShowXMLTree(true);
 	}
 	std::cout << "\n\n ";
+
+	StringHelper::Title("Read From XML Preview (In Memory)");
+	std::string preview = persist->PreviewToDisk(xDoc);
+	XMLDocument * xDocMemory = persist->FromBuffer(preview.data(), preview.size());
+	if (xDocMemory != nullptr && xDocNew != nullptr && xDocMemory->ShowXMLTree() == xDocNew->ShowXMLTree())
+		std::cout << "\n Read Operation Complete ! Same XML Document as Read From XML File.";
+	else
+		std::cout << "\n [Error] : XML Document Read From Memory Differs From XML File.";
+	std::cout << "\n\n ";
+
+	StringHelper::Title("Read Many XML Files (Batch)");
+	std::vector<std::string> paths = { "testPersistance.xml", "missing.xml", "testPersistance.xml" };
+	std::vector<LoadResult> results = persist->ToXDocs(paths, 2);
+	for (LoadResult & result : results) {
+		if (result.xDoc != nullptr && xDocNew != nullptr && result.xDoc->ShowXMLTree() == xDocNew->ShowXMLTree())
+			std::cout << "\n " << result.path << " : Same XML Document as Read by ToXDoc.";
+		else if (result.xDoc != nullptr)
+			std::cout << "\n [Error] : " << result.path << " : XML Document Differs From ToXDoc.";
+		else
+			std::cout << "\n " << result.path << " : " << result.error;
+		delete result.xDoc;
+	}
+	std::cout << "\n\n ";
 	
 	time.End();
 	std::cout << "\n ";
@@ -1,7 +1,7 @@
 //////////////////////////////////////////////////////////////////////
 // Persistance.h	:	Provides Interface to Read (or) Write XML	//
 //						Document to (or) from Disk.					//
-// Version			:	2.0											//
+// Version			:	2.4											//
 // -----------------------------------------------------------------//
 // Copyright  Venkata Chekuri, 2016								//
 // All rights granted provided that this notice is retained.		//
@@ -29,6 +29,22 @@
  *
  * CHANGELOG
  * ---------
+ * Ver 2.4 : 10/18/2026
+ *	- Added ToXDocs to Load Many Files at Once on a Pool of Threads (Each
+ *	  Reusing One Toker), With the Results (or Per File Errors) in Input
+ *	  Order.
+ *	- ToXDoc No Longer Leaks its Toker.
+ *
+ * Ver 2.3 : 10/18/2026
+ *	- ToXDoc Reads gzip / zstd Compressed Files Directly (See Toker).
+ *
+ * Ver 2.2 : 10/18/2026
+ *	- Reads Node Values & Attributes Through Node::GetValue & GetAttributes
+ *	  (Lazy Values).
+ *
+ * Ver 2.1 : 10/18/2026
+ *	- Added FromBuffer to Load XML Text Which is Already in Memory.
+ *
  * Ver 2.0 : 01/10/2017
  *	- Added Support For VERBOSE Mode.
  *	- Removed XML Protection Magic Quotes while Reading From XML File.
@@ -45,14 +61,39 @@
 #include "../XMLFileProcessor/XMLFileProcessor.h"
 
 #include <stack>
+#include <vector>
 #include <fstream>
 #include <unordered_map>
 
+/** Result of Loading One File With Persistance::ToXDocs.
+  *
+  *		- path  : The File.
+  *		- xDoc  : XMLDocument Read From it (Owned by the Caller), or nullptr
+  *		          if it Could Not be Read.
+  *		- error : Why it Could Not be Read (Empty if xDoc is Set).
+  *
+  * Dependant Class(es) or Structure(s) - XMLDocument
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+struct LoadResult {
+	LoadResult() : xDoc(nullptr) {}
+
+	std::string path;
+	XMLDocument * xDoc;
+	std::string error;
+};
+
 /** Class To Persist Data as well as To Read Data From
   * Disk (a XML File).
   *
   * Dependant Class(es) or Structure(s) - Toker, XMLDocument, StringHelper
   *
+  * Ver : 2.2
+  *		- Added ToXDocs.
+  * Ver : 2.1
+  *		- Added FromBuffer.
   * Ver : 2.0
   *		- Added Support For VERBOSE Mode.
   *		- Removed XML Protection MagicQuotes While Reading From XML File (Moved
@@ -80,6 +121,8 @@ public:
 	void ToDisk(XMLDocument * xDoc);
 	std::string PreviewToDisk(XMLDocument * xDoc, bool DisplayOnConsole = false);
 	XMLDocument * ToXDoc();
+	XMLDocument * FromBuffer(const char * data, size_t length);
+	std::vector<LoadResult> ToXDocs(const std::vector<std::string> & paths, unsigned threads = 0);
 
 	void SetVerbose(bool verbose);
 };
@@ -1,7 +1,7 @@
 //////////////////////////////////////////////////////////////////////
 // Utilities.cpp	:	Provides bunch of useful functions. Some	//
 //						or all of them are always used in project	//
-// Version			:	1.2											//
+// Version			:	1.3											//
 // -----------------------------------------------------------------//
 // Copyright  Venkata Chekuri, 2016								//
 // All rights granted provided that this notice is retained.		//
@@ -20,6 +20,17 @@
 #include <iostream>
 #include <algorithm>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 using namespace Utilities;
 
 /** Function To Print Source String Underlined With Default or
@@ -238,6 +249,122 @@ std::string Timer::TimeForTask() {
 	return res.str();
 }
 
+/** Default Constructor For MappedFile Class. Nothing is Mapped Until
+  * Open is Called.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+MappedFile::MappedFile() : data(nullptr), size(0), opened(false) {
+#ifdef _WIN32
+	hFile = INVALID_HANDLE_VALUE;
+	hMapping = nullptr;
+#else
+	fd = -1;
+#endif
+}
+
+/** Default Destructor For MappedFile Class. Unmaps the File.
+  *
+  * Dependant Function(s) - MappedFile::Close
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+MappedFile::~MappedFile() {
+	Close();
+}
+
+/** Function to Map the Whole File Read-Only Into Memory. Returns False
+  * if the File Cannot be Opened or Mapped (Caller is Expected to Fall
+  * Back to Regular Stream Reading). An Empty File is a Valid Mapping
+  * With Size Zero.
+  *
+  * Dependant Function(s) - MappedFile::Close
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool MappedFile::Open(const std::string & path) {
+	Close();
+#ifdef _WIN32
+	hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(hFile, &fileSize) || (unsigned long long)fileSize.QuadPart > (size_t)-1) {
+		Close();
+		return false;
+	}
+	size = (size_t)fileSize.QuadPart;
+	if (size != 0) {
+		hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (hMapping == nullptr) {
+			Close();
+			return false;
+		}
+		data = (const char *)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == nullptr) {
+			Close();
+			return false;
+		}
+	}
+#else
+	fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		Close();
+		return false;
+	}
+	size = (size_t)st.st_size;
+	if (size != 0) {
+		void * addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr == MAP_FAILED) {
+			Close();
+			return false;
+		}
+		madvise(addr, size, MADV_SEQUENTIAL);
+		data = (const char *)addr;
+	}
+#endif
+	opened = true;
+	return true;
+}
+
+/** Function to Unmap the File and Release the Associated Handles.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void MappedFile::Close() {
+#ifdef _WIN32
+	if (data != nullptr)
+		UnmapViewOfFile(data);
+	if (hMapping != nullptr)
+		CloseHandle(hMapping);
+	if (hFile != INVALID_HANDLE_VALUE)
+		CloseHandle(hFile);
+	hMapping = nullptr;
+	hFile = INVALID_HANDLE_VALUE;
+#else
+	if (data != nullptr)
+		munmap((void *)data, size);
+	if (fd != -1)
+		close(fd);
+	fd = -1;
+#endif
+	data = nullptr;
+	size = 0;
+	opened = false;
+}
+
 #ifdef TEST_UTILITIES
 /** Function to Test StringHelper Class.
   *
@@ -1,7 +1,7 @@
 //////////////////////////////////////////////////////////////////////
 // Utilities.h		:	Provides bunch of useful functions. Some	//
 //						or all of them are always used in project	//
-// Version			:	1.2											//
+// Version			:	1.3											//
 // -----------------------------------------------------------------//
 // Copyright  Venkata Chekuri, 2016								//
 // All rights granted provided that this notice is retained.		//
@@ -19,7 +19,8 @@
  * ------------------
  * This Package Provides Bunch Of Functions Some or All of Which
  * are most definitely used in different projects. This package
- * consists of two public classes StringHelper and Timer.
+ * consists of public classes StringHelper, Timer and MappedFile and
+ * a public structure StringSpan.
  * 
  * StringHelper Class Provides Methods which help to perform
  * string manipulation operation(s). Also it provides some methods
@@ -28,12 +29,23 @@
  * Timer Class helps to time execution of function(s), operation(s)
  * etc.
  *
+ * StringSpan Structure refers to a run of characters owned by someone
+ * else (Pointer + Length) so that text can be passed around without
+ * copying it.
+ *
+ * MappedFile Class maps a whole file read-only into memory so that its
+ * contents can be scanned as a plain character range.
+ *
  * DEPENDANT FILES
  * ---------------
  * Utilities.h, Utilities.cpp
  *
  * CHANGELOG
  * ---------
+ * Ver 1.3 : 10/18/2026
+ *	- Added StringSpan Structure.
+ *	- Added MappedFile Class.
+ *
  * Ver 1.2 : 01/11/2017
  *	- Added ToUpper and ToLower Functions.
  *	- Added PrintInBox Function.
@@ -51,6 +63,7 @@
 #include <chrono>
 #include <vector>
 #include <string>
+#include <cstddef>
 
 namespace Utilities {
 	/** Class Containing Methods to Common Help With String or 
@@ -99,5 +112,64 @@ namespace Utilities {
 		double time_taken;
 		std::vector<std::string> units = { "nanosec(s)", "microsec(s)", "millisec(s)", "sec(s)" };
 	};
+
+	/** Structure Referring to a Run of Characters Which is Owned by
+	  * Someone Else (File Mapping, Buffer or String). The Referred
+	  * Characters Must Outlive the Span.
+	  *
+	  * Dependant Class(es) or Structure(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	struct StringSpan {
+		const char * data;
+		size_t length;
+
+		StringSpan() : data(nullptr), length(0) {}
+		StringSpan(const char * _data, size_t _length) : data(_data), length(_length) {}
+		StringSpan(const std::string & str) : data(str.data()), length(str.size()) {}
+
+		bool empty() const { return length == 0; }
+		const char * begin() const { return data; }
+		const char * end() const { return data + length; }
+		std::string str() const { return std::string(data, length); }
+		bool operator==(const std::string & str) const {
+			return str.size() == length && str.compare(0, length, data, length) == 0;
+		}
+		bool operator!=(const std::string & str) const { return !(*this == str); }
+	};
+
+	/** Class to Map a Whole File Read-Only Into Memory. The Contents
+	  * Stay Valid Until Close is Called or the Object is Destroyed.
+	  *
+	  * Dependant Class(es) or Structure(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class MappedFile {
+	public:
+		MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+
+		bool Open(const std::string & path);
+		void Close();
+		bool IsOpen() const { return opened; }
+		const char * Data() const { return data; }
+		size_t Size() const { return size; }
+	private:
+		const char * data;
+		size_t size;
+		bool opened;
+#ifdef _WIN32
+		void * hFile;
+		void * hMapping;
+#else
+		int fd;
+#endif
+	};
 }
 #endif // !UTILITIES_H
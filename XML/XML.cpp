@@ -247,6 +247,35 @@ XMLDocument * XML::ToXDoc(std::string _path, bool Force) {
 	return xDoc;
 }
 
+/** Wrapper Method to Load XML Text Which is Already in Memory to XML Document
+  * (xDoc). The Text is Read In Place, Not Copied. It'll Overwrite the Content
+  * in xDoc Element (Asks First Unless Force is True).
+  *
+  * Dependant Function(s) - Persistance::Persistance, Persistance::FromBuffer
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+XMLDocument * XML::FromBuffer(const char * data, size_t length, bool Force) {
+	std::string cont = "yes";
+	if (xDoc != nullptr && !Force) {
+		std::cout << "\n [WARNING] : XML Document is Not Empty. Contents Will be Overwritten";
+		std::cout << "\n yes or no : ";
+		std::cin >> cont;
+		Utilities::StringHelper::ToLower(cont);
+	}
+
+	if (cont == "y" || cont == "yes") {
+		delete Persist;
+		Persist = new Persistance("", MagicQuotes, VERBOSE);
+		xDoc = Persist->FromBuffer(data, length);
+	}
+	else {
+		std::cout << "\n Ignoring Load XML Data Command.";
+	}
+	return xDoc;
+}
+
 #ifdef TEST_XML
 
 #include "../Utilities/Utilities.h"
@@ -326,6 +355,16 @@ int main() {
 	xml->ToXDoc("testXML.xml", true);
 	std::cout << "\n\n ";
 
+	StringHelper::Title("Loading XML Preview From Memory");
+	std::string preview = xml->PreviewToDisk();
+	std::string tree = xml->ShowXDocTree();
+	xml->FromBuffer(preview.data(), preview.size(), true);
+	if (xml->ShowXDocTree() == tree)
+		std::cout << "\n Loaded the Same XML Structure(Tree) From Memory.";
+	else
+		std::cout << "\n [Error] : XML Structure(Tree) Loaded From Memory Differs.";
+	std::cout << "\n\n ";
+
 	time.End();
 	time.TimeForTask();
 	
@@ -2,7 +2,7 @@
 // XML.h			:	Create XML Like In-Memory Structure along	//
 //						with options to Read from and Write to, XML	//
 //						Document From Disk.							//
-// Version			:	1.0											//
+// Version			:	1.1											//
 // ---------------------------------------------------------------- //
 // Copyright  Venkata Chekuri, 2016								//
 // All rights granted provided that this notice is retained.		//
@@ -33,6 +33,9 @@
  *
  * CHANGELOG
  * ---------
+ * Ver 1.1 : 10/18/2026
+ *	- Added FromBuffer to Load XML Text Which is Already in Memory.
+ *
  * Ver 1.0 : 01/11/2017
  *	- First Release
  */
@@ -76,5 +79,6 @@ public:
 	void ToDisk(std::string _path);
 	std::string PreviewToDisk(bool DisplayOnConsole = false);
 	XMLDocument * ToXDoc(std::string _path, bool Force = false);
+	XMLDocument * FromBuffer(const char * data, size_t length, bool Force = false);
 };
 #endif // !XML_H
\ No newline at end of file
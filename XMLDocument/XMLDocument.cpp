@@ -1,6 +1,6 @@
 //////////////////////////////////////////////////////////////////////
 // XMLDocument.cpp	:	Create in Memory XML Like Structure.		//
-// Version			:	2.0											//
+// Version			:	2.3											//
 // -----------------------------------------------------------------//
 // Copyright  Venkata Chekuri, 2016								//
 // All rights granted provided that this notice is retained.		//
@@ -15,295 +15,1964 @@
 
 #include "XMLDocument.h"
 
+#include <new>
+#include <tuple>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+
+const size_t NodeArena::kFirstSlabNodes;
+const size_t NodeArena::kMaxSlabNodes;
+const uint64_t XMLDocument::kOrderGap;
+const uint64_t XMLDocument::kOrderEnd;
+const uint64_t XMLDocument::kOrderShare;
+const uint32_t FlatDocument::kNoNode;
+const uint32_t SymbolTable::kNoSymbol;
+
+/** Constructor For NodeArena Class. No Slab is Allocated Until the First
+  * Node is.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+NodeArena::NodeArena() {
+	count = 0;
+}
+
+/** Destructor For NodeArena Class. Destroys Every Node Made by the Arena
+  * (a Sweep Over Each Slab) and Frees the Slabs.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+NodeArena::~NodeArena() {
+	for (Slab & slab : slabs) {
+		for (size_t i = 0; i < slab.used; i++)
+			slab.nodes[i].~Node();
+		::operator delete(slab.nodes);
+	}
+}
+
+/** Function to Make a New (Empty) Node in the Last Slab, Starting a Slab
+  * Twice as Large When it is Full.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+Node * NodeArena::New() {
+	if (slabs.empty() || slabs.back().used == slabs.back().capacity) {
+		size_t capacity = slabs.empty() ? kFirstSlabNodes : std::min(slabs.back().capacity * 2, kMaxSlabNodes);
+		Slab slab = { static_cast<Node *>(::operator new(capacity * sizeof(Node))), 0, capacity };
+		slabs.push_back(slab);
+	}
+	Slab & slab = slabs.back();
+	Node * node = new (slab.nodes + slab.used) Node();
+	slab.used++;
+	count++;
+	return node;
+}
+
+/** Function to Check Whether node Was Made by This Arena. The Newest Slab
+  * is Looked at First (Where the Node Just Made Lies).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool NodeArena::Owns(const Node * node) const {
+	std::less<const Node *> before;
+	for (size_t i = slabs.size(); i-- > 0;) {
+		const Slab & slab = slabs[i];
+		if (!before(node, slab.nodes) && before(node, slab.nodes + slab.used))
+			return true;
+	}
+	return false;
+}
+
+/** Function to Take Over Every Node of other (Which is Left Empty). The
+  * Nodes Stay Where They are; Only the Slabs Change Hands.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void NodeArena::Adopt(NodeArena & other) {
+	if (&other == this)
+		return;
+	slabs.insert(slabs.end(), other.slabs.begin(), other.slabs.end());
+	count += other.count;
+	other.slabs.clear();
+	other.count = 0;
+}
+
 /** Constructor For XMLDocument Class.
   * 
+  * Dependant Function(s) - NodeArena::New
+  *
+  * Ver : 1.1
+  *		- The Root Comes From the Document's NodeArena.
+  * Ver : 1.0
+  *		- First Release.
+  */
+XMLDocument::XMLDocument(bool verbose, std::string _version, std::string _encoding) {
+	SetVerbose(verbose);
+	version = _version;
+	encoding = _encoding;
+	foreignNodes = false;
+	tagIndexOn = false;
+	tagIndexCurrent = false;
+	valueIndexOn = false;
+	valueIndexCurrent = false;
+	valueOrderCurrent = false;
+
+	// Root element, will be used only for reference.
+	// Will not be present in XML when writing to a Document.
+	root = nodes.New();
+	root->value = "root";
+	rawSource = nullptr;
+}
+
+/** Method to Set the VERBOSE Variable.
+  * VERBOSE = True  (Enables Verbose Mode)
+  * VERBOSE = False (Disables Verbose Mode)
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::SetVerbose(bool verbose) {
+	VERBOSE = verbose;
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Verbose Mode Turned On for XMLDocument";
+}
+
+/** Function to Create An XML Node. This Function Creates 
+  * Node Without Any Arrtibutes And Children. The Node is Owned by the
+  * Document (Freed With it; Never Delete it).
+  *
+  * Dependant Function(s) - NodeArena::New
+  *
+  * Ver : 1.1
+  *		- The Node Comes From the Document's NodeArena.
+  * Ver : 1.0
+  *		- First Release.
+  */
+Node * XMLDocument::CreateNode(std::string _tag, std::string _value) {
+	Node * newNode = nodes.New();
+	newNode->tag.swap(_tag);
+	newNode->value.swap(_value);
+	return newNode;
+}
+
+/** Function to Create an Empty Node Owned by the Document (See
+  * CreateNode(_tag, _value)), For Builders Which Fill it In Place.
+  *
+  * Dependant Function(s) - NodeArena::New
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+Node * XMLDocument::CreateNode() {
+	return nodes.New();
+}
+
+/** Function to Take Over the Nodes of an Arena Filled Elsewhere (e.g. by a
+  * Builder Thread) Before They are Added to the Document. The Document
+  * Frees Them From Then On; arena is Left Empty.
+  *
+  * Dependant Function(s) - NodeArena::Adopt
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::AdoptNodes(NodeArena & arena) {
+	nodes.Adopt(arena);
+}
+
+/** Function to Add Arrtibute to A Node.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::AddAttribute(Node* _node, std::string _attribute, std::string _value) {
+	if (_node == nullptr) {
+		std::cout << "\n [Error] # Invalid Node";
+		return;
+	}
+	for (std::pair<std::string, std::string> att : _node->attributes) {
+		if (att.first == _attribute) {
+			std::cout << "\n [WARNING] : Attribute already Exists. Not adding same attribute again";
+			return;
+		}
+	}
+	_node->attributes.push_back(std::make_pair(_attribute, _value));
+}
+
+/** Function to Add Child Node to The Root Node. A Node Not Made by the
+  * Document (e.g. With new) is Deleted With it.
+  *
+  * Dependant Function(s) - NodeArena::Owns, XMLDocument::Attached
+  *
+  * Ver : 1.2
+  *		- Keeps the Tag Index Up to Date.
+  * Ver : 1.1
+  *		- Remembers Nodes Not Made by the Document (Deleted With it).
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::AddChild(Node * _node) {
+	for (Node * child : root->children) {
+		if (child == _node) {
+			std::cout << "\n [WARNING] : The node has already been added to XML";
+			return;
+		}
+	}
+	if (!nodes.Owns(_node))
+		foreignNodes = true;
+	root->children.push_back(_node);
+	Attached(_node, root);
+}
+
+/** Function to Add Child to A Specific Node.
+  * (Method Overload)
+  * 
+  * Dependant Function(s) - NodeArena::Owns, XMLDocument::Attached
+  *
+  * Ver : 1.2
+  *		- Keeps the Tag Index Up to Date.
+  * Ver : 1.1
+  *		- Remembers Nodes Not Made by the Document (Deleted With it).
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::AddChild(Node * _child, Node * _parent) {
+	if (_parent == nullptr)
+		_parent = root;
+	for (Node * child : _parent->children) {
+		if (child == _child) {
+			std::cout << "\n [WARNING] : The node has already been added to XML";
+			return;
+		}
+	}
+	if (!nodes.Owns(_child))
+		foreignNodes = true;
+	_parent->children.push_back(_child);
+	Attached(_child, _parent);
+}
+
+/** Function to Add a Newly Created Node as the Last Child of a Node
+  * (Root When _parent is nullptr). Unlike AddChild it Does Not Check
+  * Whether the Node is Already a Child, so Adding n Children Costs O(n)
+  * Instead of O(n^2). Meant For Builders Which Only Add Fresh Nodes.
+  * 
+  * Dependant Function(s) - NodeArena::Owns, XMLDocument::Attached
+  *
+  * Ver : 1.2
+  *		- Keeps the Tag Index Up to Date.
+  * Ver : 1.1
+  *		- Remembers Nodes Not Made by the Document (Deleted With it).
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::AppendChild(Node * _child, Node * _parent) {
+	if (_parent == nullptr)
+		_parent = root;
+	if (!nodes.Owns(_child))
+		foreignNodes = true;
+	_parent->children.push_back(_child);
+	Attached(_child, _parent);
+}
+
+/** Function to Take a Child (and its Subtree) Out of a Node (Root When
+  * _parent is nullptr). Nodes Made by the Document are Still Freed With it;
+  * Other Nodes of the Subtree Belong to the Caller Again. Returns False if
+  * _child is Not a Child of _parent.
+  *
+  * Dependant Function(s) - XMLDocument::DropValue
+  *
+  * Ver : 1.1
+  *		- Also Takes the Nodes Out of the Value Index.
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool XMLDocument::RemoveChild(Node * _child, Node * _parent) {
+	if (_parent == nullptr)
+		_parent = root;
+	std::vector<Node *>::iterator found = std::find(_parent->children.begin(), _parent->children.end(), _child);
+	if (found == _parent->children.end()) {
+		std::cout << "\n [WARNING] : The node is not a child of the given node";
+		return false;
+	}
+	_parent->children.erase(found);
+	if (!tagIndexCurrent && !valueIndexCurrent)
+		return true;
+
+	// Take the Subtree's Nodes Out of Their Lists (Keeping the Order).
+	std::vector<Node *> removed(1, _child);
+	for (size_t i = 0; i < removed.size(); i++)
+		removed.insert(removed.end(), removed[i]->children.begin(), removed[i]->children.end());
+	std::sort(removed.begin(), removed.end());
+	std::function<bool(Node *)> isRemoved = [&removed](Node * node) {
+		return std::binary_search(removed.begin(), removed.end(), node);
+	};
+	if (tagIndexCurrent) {
+		std::vector<std::string> tags;
+		for (Node * node : removed) {
+			if (std::find(tags.begin(), tags.end(), node->tag) == tags.end())
+				tags.push_back(node->tag);
+		}
+		for (const std::string & tag : tags) {
+			std::vector<Node *> & list = tagIndex[tag];
+			list.erase(std::remove_if(list.begin(), list.end(), isRemoved), list.end());
+		}
+	}
+	if (valueIndexCurrent) {
+		std::vector<std::unordered_map<std::string, std::vector<Node *>>::iterator> entries;
+		for (Node * node : removed) {
+			std::unordered_map<std::string, std::vector<Node *>>::iterator entry = valueIndex.find(node->GetValue());
+			if (entry != valueIndex.end() && std::find(entries.begin(), entries.end(), entry) == entries.end())
+				entries.push_back(entry);
+		}
+		for (std::unordered_map<std::string, std::vector<Node *>>::iterator entry : entries) {
+			std::vector<Node *> & list = entry->second;
+			list.erase(std::remove_if(list.begin(), list.end(), isRemoved), list.end());
+			if (list.empty())
+				DropValue(entry);
+		}
+	}
+
+	// The Last Node May Have Been Removed; Walk Down From the Root Again
+	// (Nothing Follows the Nodes on the Path Now).
+	if (std::find(lastPath.begin(), lastPath.end(), _child) != lastPath.end()) {
+		lastPath.assign(1, root);
+		while (!lastPath.back()->children.empty())
+			lastPath.push_back(lastPath.back()->children.back());
+		for (Node * node : lastPath)
+			node->orderEnd = kOrderEnd;
+	}
+	return true;
+}
+
+/** Function to Change the Tag of a Node, Keeping the Tag Index Up to
+  * Date : the Node Moves From the List of its Old Tag to its Place (by
+  * Document Order) in the List of the New One. Nodes Not in the Document
+  * are Only Changed.
+  *
+  * Dependant Function(s) - XMLDocument::FindOrdered, XMLDocument::InsertOrdered
+  *
+  * Ver : 1.1
+  *		- Moves the Node Between Lists Instead of Making the Index Stale.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::SetTag(Node * _node, const std::string & _tag) {
+	if (_node == nullptr) {
+		std::cout << "\n [Error] # Invalid Node";
+		return;
+	}
+	if (_node->tag == _tag)
+		return;
+	if (tagIndexCurrent) {
+		std::unordered_map<std::string, std::vector<Node *>>::iterator entry = tagIndex.find(_node->tag);
+		std::vector<Node *>::iterator found;
+		if (entry != tagIndex.end() && (found = FindOrdered(entry->second, _node)) != entry->second.end()) {
+			entry->second.erase(found);
+			if (entry->second.empty())
+				tagIndex.erase(entry);
+			InsertOrdered(tagIndex[_tag], _node);
+		}
+	}
+	_node->tag = _tag;
+}
+
+/** Function to Change the Value of a Node (Like Node::SetValue), Keeping
+  * the Value Index Up to Date : the Node Leaves the List of its Old Value
+  * and is Put in Place (by its Stamp) in the List of its New Value. Nodes
+  * Not in the Document are Only Changed.
+  *
+  * Dependant Function(s) - Node::SetValue, XMLDocument::FindOrdered,
+  *							XMLDocument::IndexValue, XMLDocument::DropValue
+  *
+  * Ver : 1.1
+  *		- A Value Other Nodes Have Too No Longer Makes the Index Stale.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::SetValue(Node * _node, const std::string & _value) {
+	if (_node == nullptr) {
+		std::cout << "\n [Error] # Invalid Node";
+		return;
+	}
+	if (!valueIndexCurrent || _node->GetValue() == _value) {
+		_node->SetValue(_value);
+		return;
+	}
+	std::unordered_map<std::string, std::vector<Node *>>::iterator entry = valueIndex.find(_node->value);
+	std::vector<Node *>::iterator found;
+	bool indexed = entry != valueIndex.end() &&
+		(found = FindOrdered(entry->second, _node)) != entry->second.end();
+	_node->SetValue(_value);
+	if (!indexed)
+		return;
+	entry->second.erase(found);
+	if (entry->second.empty())
+		DropValue(entry);
+	IndexValue(_node);
+}
+
+/** Function to Keep the Indexes Up to Date When _child (and its Subtree)
+  * Has Just Been Added as the Last Child of _parent (Which Does Nothing if
+  * _parent is Not in the Document). The Subtree Comes Right After the Last
+  * Node of _parent's Other Children (or _parent), so its Nodes are Stamped
+  * Between That Node and _parent->orderEnd, and the Nodes Whose Subtrees
+  * Ended There Now End at _child. When the Stamps Between Have Run Out,
+  * _parent's Subtree is Stamped Again Over its Own Range (or if That is
+  * Full Too, the Document is Renumbered). Builders Add Under the Innermost
+  * Open Node, Which is Found at the End of lastPath Right Away, so They
+  * Append to the Lists.
+  *
+  * Dependant Function(s) - XMLDocument::Indexed, XMLDocument::Stamp,
+  *		XMLDocument::Renumber, XMLDocument::InsertOrdered, XMLDocument::IndexValue
+  *
+  * Ver : 1.3
+  *		- Nor the Value Index.
+  * Ver : 1.2
+  *		- Subtrees Added Anywhere are Put in Place (Document Order Stamps)
+  *		  Instead of Making the Tag Index Stale.
+  * Ver : 1.1
+  *		- Also Keeps the Value Index Up to Date.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::Attached(Node * _child, Node * _parent) {
+	if (!tagIndexCurrent && !valueIndexCurrent)
+		return;
+	size_t depth = lastPath.size();
+	while (depth > 0 && lastPath[depth - 1] != _parent)
+		depth--;
+	if (depth == 0 && !Indexed(_parent))
+		return;
+
+	// The Subtree's Nodes in Document Order (a Leaf Needs No List).
+	std::vector<Node *> added;
+	if (!_child->children.empty()) {
+		std::vector<Node *> pending(1, _child);
+		while (!pending.empty()) {
+			added.push_back(pending.back());
+			pending.pop_back();
+			pending.insert(pending.end(), added.back()->children.rbegin(), added.back()->children.rend());
+		}
+	}
+	size_t count = added.empty() ? 1 : added.size();
+	Node * previous = _parent->children.size() > 1 ? _parent->children[_parent->children.size() - 2] : nullptr;
+	Node * last = depth > 0 ? lastPath.back() : previous == nullptr ? _parent : previous;
+	if (depth == 0 && previous != nullptr) {
+		while (!last->children.empty())
+			last = last->children.back();
+	}
+
+	// Stamp the Subtree After the Last Node, Leaving Most of the Room for
+	// Later Adds There; With no Room Spread _parent's Subtree Over the First
+	// Half of its Range, or Failing That Renumber All.
+	uint64_t room = _parent->orderEnd - last->order;
+	uint64_t step = std::min(kOrderGap, room / (count + kOrderShare));
+	if (step == 0)
+		step = room / (count + 1);
+	if (step > 0) {
+		Stamp(_child, last->order + step, step, _parent->orderEnd);
+		for (Node * node = previous; node != nullptr; node = node->children.empty() ? nullptr : node->children.back())
+			node->orderEnd = _child->order;
+	}
+	else {
+		uint64_t size = 0;
+		std::vector<Node *> pending(1, _parent);
+		while (!pending.empty()) {
+			Node * node = pending.back();
+			pending.pop_back();
+			pending.insert(pending.end(), node->children.begin(), node->children.end());
+			size++;
+		}
+		step = std::min(kOrderGap, (_parent->orderEnd - _parent->order) / (2 * size + 1));
+		if (step > 0 && _parent != root)
+			Stamp(_parent, _parent->order, step, _parent->orderEnd);
+		else {
+			Renumber();
+			depth = 0;
+		}
+	}
+	if (depth > 0) {
+		lastPath.resize(depth);
+		for (Node * node = _child; node != nullptr; node = node->children.empty() ? nullptr : node->children.back())
+			lastPath.push_back(node);
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		Node * node = added.empty() ? _child : added[i];
+		if (tagIndexCurrent)
+			InsertOrdered(tagIndex[node->tag], node);
+		if (valueIndexCurrent)
+			IndexValue(node);
+	}
+}
+
+/** Function to Append the Nodes of a Subtree (in Document Order) to Their
+  * Tag Lists (tags) and / or Value Lists (values). Used When the Lists are
+  * Built Afresh.
+  *
+  * Dependant Function(s) - XMLDocument::IndexValue
+  *
+  * Ver : 1.2
+  *		- No Longer Extends lastPath (See Renumber).
+  * Ver : 1.1
+  *		- Also Indexes Values.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::IndexSubtree(Node * _node, bool tags, bool values) {
+	std::vector<Node *> pending(1, _node);
+	while (!pending.empty()) {
+		Node * node = pending.back();
+		pending.pop_back();
+		if (tags)
+			tagIndex[node->tag].push_back(node);
+		if (values)
+			IndexValue(node);
+		pending.insert(pending.end(), node->children.rbegin(), node->children.rend());
+	}
+}
+
+/** Function to Stamp a Subtree in Document Order : _node Gets first, Each
+  * Following Node step More. A Node's orderEnd is the Stamp of the Node
+  * After its Subtree, or end For the Nodes Whose Subtrees End the Subtree.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::Stamp(Node * _node, uint64_t first, uint64_t step, uint64_t end) {
+	uint64_t next = first;
+	_node->order = next;
+	_node->orderEnd = end;
+	if (_node->children.empty())
+		return;
+	std::vector<std::pair<Node *, size_t>> open(1, std::make_pair(_node, (size_t)0));
+	while (!open.empty()) {
+		Node * node = open.back().first;
+		if (open.back().second < node->children.size()) {
+			Node * child = node->children[open.back().second++];
+			next += step;
+			child->order = next;
+			open.push_back(std::make_pair(child, (size_t)0));
+		}
+		else {
+			node->orderEnd = next + step;
+			open.pop_back();
+		}
+	}
+	for (Node * node = _node; node != nullptr; node = node->children.empty() ? nullptr : node->children.back())
+		node->orderEnd = end;
+}
+
+/** Function to Stamp the Whole Document Again (kOrderGap Apart) and Find
+  * the Path to its Last Node. The Order of the Nodes is Kept, so the
+  * Indexes Stay Current.
+  *
+  * Dependant Function(s) - XMLDocument::Stamp
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::Renumber() {
+	Stamp(root, 0, kOrderGap, kOrderEnd);
+	lastPath.assign(1, root);
+	while (!lastPath.back()->children.empty())
+		lastPath.push_back(lastPath.back()->children.back());
+}
+
+/** Function to Tell Whether a Node is in the Document (Which Must Have a
+  * Current Index) : it is the Root, or it is Found by its Stamp in the
+  * List of its Tag (or Value).
+  *
+  * Dependant Function(s) - XMLDocument::FindOrdered
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool XMLDocument::Indexed(Node * _node) {
+	if (_node == root)
+		return true;
+	std::unordered_map<std::string, std::vector<Node *>> & index = tagIndexCurrent ? tagIndex : valueIndex;
+	std::unordered_map<std::string, std::vector<Node *>>::iterator entry =
+		index.find(tagIndexCurrent ? _node->tag : _node->GetValue());
+	return entry != index.end() && FindOrdered(entry->second, _node) != entry->second.end();
+}
+
+/** Function to Find a Node in a List Kept in Document Order, by its Stamp.
+  * Returns list.end() if it is Not There.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<Node *>::iterator XMLDocument::FindOrdered(std::vector<Node *> & list, Node * _node) {
+	std::vector<Node *>::iterator found = std::lower_bound(list.begin(), list.end(), _node,
+		[](Node * a, Node * b) { return a->order < b->order; });
+	return found != list.end() && *found == _node ? found : list.end();
+}
+
+/** Function to Put a Node in its Place (by its Stamp) in a List Kept in
+  * Document Order. Nodes Which Come Last are Just Appended.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::InsertOrdered(std::vector<Node *> & list, Node * _node) {
+	if (list.empty() || list.back()->order < _node->order)
+		list.push_back(_node);
+	else
+		list.insert(std::lower_bound(list.begin(), list.end(), _node,
+			[](Node * a, Node * b) { return a->order < b->order; }), _node);
+}
+
+/** Function to Put a Node in the List of its Value (Decoding a Lazy
+  * Value). A New Value Also Goes in the Ordered Set When That is Built.
+  *
+  * Dependant Function(s) - Node::GetValue, XMLDocument::InsertOrdered
+  *
+  * Ver : 1.1
+  *		- Puts the Node in Place by its Stamp (Appends Stay Appends).
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::IndexValue(Node * _node) {
+	const std::string & value = _node->GetValue();
+	std::unordered_map<std::string, std::vector<Node *>>::iterator entry = valueIndex.find(value);
+	if (entry == valueIndex.end()) {
+		entry = valueIndex.emplace(value, std::vector<Node *>()).first;
+		if (valueOrderCurrent)
+			valueOrder.insert(&*entry);
+	}
+	InsertOrdered(entry->second, _node);
+}
+
+/** Function to Remove a Value no Node Has Anymore From the Value Index
+  * (and the Ordered Set).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::DropValue(std::unordered_map<std::string, std::vector<Node *>>::iterator entry) {
+	if (valueOrderCurrent)
+		valueOrder.erase(&*entry);
+	valueIndex.erase(entry);
+}
+
+/** Function to Build the Tag Index Afresh : the Document is Stamped, Then
+  * its Nodes are Put in Their Lists.
+  *
+  * Dependant Function(s) - XMLDocument::Renumber, XMLDocument::IndexSubtree
+  *
+  * Ver : 1.1
+  *		- Stamps the Document (Renumber).
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::RebuildTagIndex() {
+	tagIndex.clear();
+	Renumber();
+	for (Node * child : root->children)
+		IndexSubtree(child, true, false);
+	tagIndexCurrent = true;
+}
+
+/** Function to Build the Value Index Afresh With One Walk Over the Tree.
+  * The Ordered Set is Left to be Built by the First Query Which Needs it.
+  *
+  * Dependant Function(s) - XMLDocument::Renumber, XMLDocument::IndexSubtree
+  *
+  * Ver : 1.1
+  *		- Stamps the Document (Renumber).
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::RebuildValueIndex() {
+	valueOrder.clear();
+	valueOrderCurrent = false;
+	valueIndex.clear();
+	Renumber();
+	for (Node * child : root->children)
+		IndexSubtree(child, false, true);
+	valueIndexCurrent = true;
+}
+
+/** Function to Build the Ordered Set of the Value Index : the Entries are
+  * Sorted Once, Then the Set is Made From Them in Linear Time.
+  *
+  * Dependant Function(s) - XMLDocument::FoldedLess
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::RebuildValueOrder() {
+	std::vector<const ValueEntry *> entries;
+	entries.reserve(valueIndex.size());
+	for (const ValueEntry & entry : valueIndex)
+		entries.push_back(&entry);
+	std::sort(entries.begin(), entries.end(), FoldedLess());
+	std::set<const ValueEntry *, FoldedLess>(entries.begin(), entries.end()).swap(valueOrder);
+	valueOrderCurrent = true;
+}
+
+/** Function to Turn the Tag Index On or Off (Off by Default). Turning it
+  * On Does Not Build it; the First getElementByTag Does (See BuildTagIndex
+  * to Build it Right Away). Turning it Off Frees it (and the Path to the
+  * Last Node, Unless the Value Index Still Uses it).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.1
+  *		- Keeps lastPath While the Value Index is Current.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::SetTagIndex(bool enabled) {
+	tagIndexOn = enabled;
+	if (enabled)
+		return;
+	tagIndexCurrent = false;
+	std::unordered_map<std::string, std::vector<Node *>>().swap(tagIndex);
+	if (!valueIndexCurrent)
+		std::vector<Node *>().swap(lastPath);
+}
+
+/** Function to Turn the Tag Index On and Build it Now. On an Empty
+  * Document (e.g. Before a Builder Fills it) the Index is Then Kept Up to
+  * Date Node by Node as the Document is Built.
+  *
+  * Dependant Function(s) - XMLDocument::RebuildTagIndex
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::BuildTagIndex() {
+	tagIndexOn = true;
+	RebuildTagIndex();
+}
+
+/** Function to Tell the Document its Nodes Were Changed Directly (tag,
+  * value or children), so the Indexes are Rebuilt on the Next Query.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.1
+  *		- Also Covers the Value Index.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::InvalidateIndexes() {
+	tagIndexCurrent = false;
+	valueIndexCurrent = false;
+}
+
+/** Function to Get the Bytes the Tag Index Holds (Lists, Hash Nodes &
+  * Buckets and the Path to the Last Node; Hash Nodes are Estimated as the
+  * Entry Plus a Link and a Cached Hash). 0 When the Index is Off.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+size_t XMLDocument::TagIndexMemoryUsage() const {
+	if (!tagIndexOn)
+		return 0;
+	size_t bytes = tagIndex.bucket_count() * sizeof(void *) + lastPath.capacity() * sizeof(Node *);
+	for (const std::pair<const std::string, std::vector<Node *>> & entry : tagIndex) {
+		bytes += sizeof(entry) + sizeof(void *) + sizeof(size_t) + entry.second.capacity() * sizeof(Node *);
+		if (entry.first.capacity() > sizeof(std::string))
+			bytes += entry.first.capacity() + 1;
+	}
+	return bytes;
+}
+
+/** Function to Turn the Value Index On or Off (Off by Default). Turning it
+  * On Does Not Build it; the First Value Query Does (See BuildValueIndex to
+  * Build it Right Away). Turning it Off Frees it (and the Path to the Last
+  * Node, Unless the Tag Index Still Uses it).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::SetValueIndex(bool enabled) {
+	valueIndexOn = enabled;
+	if (enabled)
+		return;
+	valueIndexCurrent = valueOrderCurrent = false;
+	std::set<const ValueEntry *, FoldedLess>().swap(valueOrder);
+	std::unordered_map<std::string, std::vector<Node *>>().swap(valueIndex);
+	if (!tagIndexCurrent)
+		std::vector<Node *>().swap(lastPath);
+}
+
+/** Function to Turn the Value Index On and Build it Now (Without the
+  * Ordered Set).
+  *
+  * Dependant Function(s) - XMLDocument::RebuildValueIndex
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::BuildValueIndex() {
+	valueIndexOn = true;
+	RebuildValueIndex();
+}
+
+/** Function to Get the Bytes the Value Index Holds (Lists, Hash Nodes &
+  * Buckets, and the Ordered Set if Built; Hash and Tree Nodes are Estimated
+  * as the Entry Plus Their Links). The Path to the Last Node is Counted
+  * With the Tag Index. 0 When the Index is Off.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+size_t XMLDocument::ValueIndexMemoryUsage() const {
+	if (!valueIndexOn)
+		return 0;
+	size_t bytes = valueIndex.bucket_count() * sizeof(void *);
+	for (const ValueEntry & entry : valueIndex) {
+		bytes += sizeof(entry) + sizeof(void *) + sizeof(size_t) + entry.second.capacity() * sizeof(Node *);
+		if (entry.first.capacity() > sizeof(std::string))
+			bytes += entry.first.capacity() + 1;
+	}
+	if (valueOrderCurrent)
+		bytes += valueOrder.size() * (sizeof(const ValueEntry *) + 4 * sizeof(void *));
+	return bytes;
+}
+
+/** Function to Delete Each Node in the XML Structure (Tree) Which Was Not
+  * Made by arena (Those are Freed With the Arena). Walks the Tree With an
+  * Explicit Stack, so Deep Documents Cannot Overflow the Call Stack.
+  * This Function will is Intended to Prevent Memory Loss Issues.
+  *
+  * Dependant Function(s) - NodeArena::Owns
+  *
+  * Ver : 1.1
+  *		- Deletes Interior Nodes Too (Only Leaves Were Deleted) and Leaves
+  *		  the Arena's Nodes Alone.
+  * Ver : 1.0
+  *		- First Release.
+  */
+static void CleanUpHelper(Node * _root, const NodeArena & arena) {
+	std::vector<Node *> pending(1, _root);
+	while (!pending.empty()) {
+		Node * node = pending.back();
+		pending.pop_back();
+		pending.insert(pending.end(), node->children.begin(), node->children.end());
+		if (!arena.Owns(node))
+			delete node;
+	}
+}
+/** Function to Get All the Child Elements of a Specific Node.
+  * 
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<Node *> XMLDocument::getDescendants(const Node * _node) {
+	std::vector<Node *> result;
+	if (_node == nullptr)
+		return result;
+	for (Node * child : _node->children) {
+		result.push_back(child);
+	}
+	return result;
+}
+
+/** Default Destructor for XMLDocument Class.
+  * Deletes All the Node(s) associated with XML Structure (Tree). The Nodes
+  * the Document Made are Freed With its NodeArena; the Tree is Only Walked
+  * if Nodes Made Elsewhere Were Added.
+  * 
+  * Dependant Function(s) - XMLDocument::CleanUpHelper, NodeArena::~NodeArena
+  *
+  * Ver : 1.2
+  *		- Frees the Arena Instead of Deleting Node by Node (and No Longer
+  *		  Leaks Nodes With Children).
+  * Ver : 1.1
+  *		- Also Deletes the RawSource.
+  * Ver : 1.0
+  *		- First Release.
+  */
+XMLDocument::~XMLDocument() {
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Destroying All the Nodes";
+	if (foreignNodes)
+		CleanUpHelper(root, nodes);
+	delete rawSource;
+}
+
+/** Function to Display All Node Information.
+  * 
+  * Dependant Function(s) - Node::ShowInfo
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::ShowNode(Node * node) {
+	node->ShowInfo();
+}
+
+std::string XMLDocument::ShowXMLTree(bool print) {
+	std::string result;
+	ShowXMLTreeHelper(result, root, 0);
+	if (print)
+		std::cout << result;
+	return result;
+}
+
+/** Function to Display XML Structure(Tree) Similar to
+  * Output of Tree Command in Windows/Linux
+  * Does not Display Attributes.
+  * 
+  * Dependant Function(s) - Node::GetValue
+  *
+  * Ver : 1.1
+  *		- Reads the Value Through GetValue (Lazy Values).
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::ShowXMLTreeHelper(std::string & tree, Node * node, int indent) {
+	tree.push_back('\n');
+	tree.push_back('|');
+	if (indent != 0) {
+		int last = indent - 1;
+		for (int i = 0; i < indent; i++) {
+			if (i == last) {
+				if (i != 0) {
+					tree.push_back('|');
+					tree.append("-----");
+				}
+				else {
+					tree.append("-----");
+				}
+			} else
+				tree.push_back('\t');
+		}
+	} 
+
+	tree.append(std::string("[" + node->tag + "] : "));
+	if (node->GetValue() == "")
+		tree.append("N/A");
+	else
+		tree.append(node->GetValue());
+
+	if (node->children.size() != 0) {
+		for (size_t i = 0; i < node->children.size(); i++) {
+			ShowXMLTreeHelper(tree, node->children[i], indent + 1);
+		}
+	}
+}
+
+/** Function to Perform A Query On XML to Get All Elements With A Specific
+  * Tag Name (in Document Order). With the Tag Index On the List is Copied
+  * From the Index (Rebuilt First if it is Stale).
+  *
+  * Dependant Function(s) - XMLDocument::getElementByTagHelper,
+  *		XMLDocument::RebuildTagIndex
+  *
+  * Ver : 1.1
+  *		- Answered From the Tag Index When it is On.
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<Node *> XMLDocument::getElementByTag(const std::string & _tagName) {
+	if (tagIndexOn) {
+		if (!tagIndexCurrent)
+			RebuildTagIndex();
+		std::unordered_map<std::string, std::vector<Node *>>::const_iterator found = tagIndex.find(_tagName);
+		return found == tagIndex.end() ? std::vector<Node *>() : found->second;
+	}
+	std::vector<Node *> results;
+	getElementByTagHelper(results, root, _tagName);
+	return results;
+}
+
+/** Helper Function For GetElementByTag Function.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::getElementByTagHelper(std::vector<Node *> &vec, Node * node, const std::string & _tagname) {
+	if (node == nullptr) {
+		return;
+	}
+
+	if (node != root && node->tag == _tagname) {
+		vec.push_back(node);
+	}
+
+	if (!node->children.empty()) {
+		for (Node * child : node->children) {
+			getElementByTagHelper(vec, child, _tagname);
+		}
+	}
+}
+
+/** Function to Perform A Query On XML to Get All Elements With A Specific
+  * Value (in Document Order). With the Value Index On the List is Copied
+  * From the Index (Rebuilt First if it is Stale).
+  *
+  * Dependant Function(s) - XMLDocument::getElementByValueHelper,
+  *		XMLDocument::RebuildValueIndex
+  *
+  * Ver : 1.1
+  *		- Answered From the Value Index When it is On.
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<Node *> XMLDocument::getElementByValue(const std::string & _value) {
+	if (valueIndexOn) {
+		if (!valueIndexCurrent)
+			RebuildValueIndex();
+		std::unordered_map<std::string, std::vector<Node *>>::const_iterator found = valueIndex.find(_value);
+		return found == valueIndex.end() ? std::vector<Node *>() : found->second;
+	}
+	std::vector<Node *> results;
+	getElementByValueHelper(results, root, _value);
+	return results;
+}
+
+/** Function to Get All Elements Whose Value Equals _value Ignoring ASCII
+  * Case. Matches are Grouped by Value (in the Order of FoldedLess), Each
+  * Group in Document Order.
+  *
+  * Dependant Function(s) - XMLDocument::getElementByValueOrdered
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<Node *> XMLDocument::getElementByValueIgnoreCase(const std::string & _value) {
+	return getElementByValueOrdered(_value, false, true);
+}
+
+/** Function to Get All Elements Whose Value Starts With _prefix (Ignoring
+  * ASCII Case if ignoreCase is Set). Matches are Grouped by Value (in the
+  * Order of FoldedLess), Each Group in Document Order.
+  *
+  * Dependant Function(s) - XMLDocument::getElementByValueOrdered
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<Node *> XMLDocument::getElementByValuePrefix(const std::string & _prefix, bool ignoreCase) {
+	return getElementByValueOrdered(_prefix, true, ignoreCase);
+}
+
+/** Function to Fold an ASCII Letter to Lower Case (Other Bytes, Including
+  * Those of UTF-8 Sequences, are Left Alone).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+static inline unsigned char FoldCase(char ch) {
+	return ch >= 'A' && ch <= 'Z' ? (unsigned char)(ch - 'A' + 'a') : (unsigned char)ch;
+}
+
+/** Function to Tell Whether value Matches key : Equal to it, or Starting
+  * With it When prefix is Set, Ignoring ASCII Case When ignoreCase is Set.
+  *
+  * Dependant Function(s) - FoldCase
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+static bool ValueMatches(const std::string & value, const std::string & key, bool prefix, bool ignoreCase) {
+	if (prefix ? value.size() < key.size() : value.size() != key.size())
+		return false;
+	if (!ignoreCase)
+		return value.compare(0, key.size(), key) == 0;
+	for (size_t i = 0; i < key.size(); i++) {
+		if (FoldCase(value[i]) != FoldCase(key[i]))
+			return false;
+	}
+	return true;
+}
+
+/** Function to Order Two Values by Their Case Folded Text, and Values
+  * Which Fold the Same by Their Text.
+  *
+  * Dependant Function(s) - FoldCase
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+static bool FoldedBefore(const std::string & left, const std::string & right) {
+	size_t length = std::min(left.size(), right.size());
+	for (size_t i = 0; i < length; i++) {
+		unsigned char l = FoldCase(left[i]), r = FoldCase(right[i]);
+		if (l != r)
+			return l < r;
+	}
+	if (left.size() != right.size())
+		return left.size() < right.size();
+	return left < right;
+}
+
+/** Function to Order Two Value Index Entries by Their Values (See
+  * FoldedBefore).
+  *
+  * Dependant Function(s) - FoldedBefore
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool XMLDocument::FoldedLess::operator()(const ValueEntry * a, const ValueEntry * b) const {
+	return FoldedBefore(a->first, b->first);
+}
+
+/** Function to Answer Value Queries Ignoring Case and / or by Prefix. With
+  * the Value Index On the Values Which Match Ignoring Case are a Run of the
+  * Ordered Set, Starting Where the Key With its ASCII Letters in Upper Case
+  * Would Be (it Sorts First Among the Values Which Fold Like it); Values in
+  * the Run Which Differ in Case are Skipped Unless ignoreCase. Without the
+  * Index the Tree is Walked and the Matches Put in the Same Order.
+  *
+  * Dependant Function(s) - XMLDocument::RebuildValueIndex,
+  *		XMLDocument::RebuildValueOrder, XMLDocument::getElementByValueHelper,
+  *		FoldedBefore
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<Node *> XMLDocument::getElementByValueOrdered(const std::string & _key, bool prefix, bool ignoreCase) {
+	std::vector<Node *> results;
+	if (!valueIndexOn) {
+		getElementByValueHelper(results, root, _key, prefix, ignoreCase);
+		std::stable_sort(results.begin(), results.end(),
+			[](Node * a, Node * b) { return FoldedBefore(a->value, b->value); });
+		return results;
+	}
+	if (!valueIndexCurrent)
+		RebuildValueIndex();
+	if (!valueOrderCurrent)
+		RebuildValueOrder();
+
+	ValueEntry probe(_key, std::vector<Node *>());
+	std::string & first = const_cast<std::string &>(probe.first);
+	for (char & ch : first) {
+		if (ch >= 'a' && ch <= 'z')
+			ch = ch - 'a' + 'A';
+	}
+	for (std::set<const ValueEntry *, FoldedLess>::const_iterator it = valueOrder.lower_bound(&probe);
+		it != valueOrder.end() && ValueMatches((*it)->first, _key, prefix, true); ++it) {
+		if (ignoreCase || ValueMatches((*it)->first, _key, prefix, false))
+			results.insert(results.end(), (*it)->second.begin(), (*it)->second.end());
+	}
+	return results;
+}
+
+/** Helper Function For GetElementByValue (and the Prefix / Ignore Case
+  * Queries Without the Value Index).
+  *
+  * Dependant Function(s) - Node::GetValue, ValueMatches
+  *
+  * Ver : 1.2
+  *		- Also Matches by Prefix and / or Ignoring Case.
+  * Ver : 1.1
+  *		- Reads the Value Through GetValue (Lazy Values).
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::getElementByValueHelper(std::vector<Node *> &vec, Node * node, const std::string & _value,
+	bool prefix, bool ignoreCase) {
+	if (node == nullptr) {
+		return;
+	}
+
+	if (node != root && ValueMatches(node->GetValue(), _value, prefix, ignoreCase)) {
+		vec.push_back(node);
+	}
+
+	if (!node->children.empty()) {
+		for (Node * child : node->children) {
+			getElementByValueHelper(vec, child, _value, prefix, ignoreCase);
+		}
+	}
+}
+
+/** Function to Get XML Version.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::string XMLDocument::getVersion() {
+	return version;
+}
+
+
+/** Function to Set XML Version.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::setVersion(std::string & _version) {
+	version = _version;
+}
+
+
+/** Function to Get XML Encoding.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::string XMLDocument::getEncoding() {
+	return encoding;
+}
+
+/** Function to Set XML Encoding.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::setEncoding(std::string & _encoding) {
+	encoding = _encoding;
+}
+
+/** Function to Get Root Element of XML.
+  * 
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+Node * XMLDocument::getRoot() {
+	return root;
+}
+
+/** Function to Hand Over the Input Lazy Values Refer to. The XMLDocument
+  * Owns it From Then On (Deleted With the Document).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void XMLDocument::setRawSource(RawSource * _source) {
+	if (_source == rawSource)
+		return;
+	delete rawSource;
+	rawSource = _source;
+}
+
+/** Constructor For SymbolTable Class. The Table is Empty.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+SymbolTable::SymbolTable() {}
+
+/** Function to Get the Id of a Name, Adding it to the Table if it is Not
+  * There Yet. Looking Up a Name Already There Does Not Allocate. Returns
+  * kNoSymbol if the Table Holds as Many Names as Ids Can Tell Apart.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+uint32_t SymbolTable::Intern(const Utilities::StringSpan & name) {
+	key.assign(name.data, name.length);
+	std::unordered_map<std::string, uint32_t>::const_iterator found = ids.find(key);
+	if (found != ids.end())
+		return found->second;
+	if (names.size() >= kNoSymbol)
+		return kNoSymbol;
+	uint32_t id = (uint32_t)names.size();
+	names.push_back(&ids.emplace(key, id).first->first);
+	return id;
+}
+
+/** Function to Get the Id of a Name Without Adding it (kNoSymbol if it is
+  * Not in the Table).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+uint32_t SymbolTable::Find(const std::string & name) const {
+	std::unordered_map<std::string, uint32_t>::const_iterator found = ids.find(name);
+	return found == ids.end() ? kNoSymbol : found->second;
+}
+
+/** Function to Get the Name With a Given Id (Which Must Come From This
+  * Table).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+const std::string & SymbolTable::Name(uint32_t id) const {
+	return *names[id];
+}
+
+/** Function to Get the Bytes the Table Holds (Names, Hash Nodes & Buckets;
+  * Hash Nodes are Estimated as the Entry Plus a Link and a Cached Hash).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+size_t SymbolTable::MemoryUsage() const {
+	size_t bytes = sizeof(SymbolTable) + names.capacity() * sizeof(const std::string *)
+		+ ids.bucket_count() * sizeof(void *) + key.capacity();
+	for (const std::string * name : names) {
+		bytes += sizeof(std::pair<const std::string, uint32_t>) + sizeof(void *) + sizeof(size_t);
+		if (name->capacity() > sizeof(std::string))
+			bytes += name->capacity() + 1;
+	}
+	return bytes;
+}
+
+/** Constructor For NodeHandle Class. The Handle Refers to No Node.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+NodeHandle::NodeHandle() : doc(nullptr), index(FlatDocument::kNoNode) {}
+
+/** Constructor For NodeHandle Class. The Handle Refers to Node _index of
+  * _doc.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+NodeHandle::NodeHandle(const FlatDocument * _doc, uint32_t _index) : doc(_doc), index(_index) {}
+
+/** Function to Tell Whether the Handle Refers to a Node of its Document.
+  * The Other Functions Return Empty Spans and Invalid Handles Otherwise.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool NodeHandle::IsValid() const {
+	return doc != nullptr && index < doc->records.size();
+}
+
+/** Function to Get the Tag of the Node.
+  *
+  * Dependant Function(s) - SymbolTable::Name
+  *
+  * Ver : 1.1
+  *		- The Tag is Read From the SymbolTable.
+  * Ver : 1.0
+  *		- First Release.
+  */
+Utilities::StringSpan NodeHandle::Tag() const {
+	if (!IsValid())
+		return Utilities::StringSpan();
+	return Utilities::StringSpan(doc->symbols->Name(doc->records[index].tag));
+}
+
+/** Function to Get the Id of the Tag of the Node in its Document's
+  * SymbolTable (kNoSymbol For an Invalid Handle).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+uint32_t NodeHandle::TagId() const {
+	return IsValid() ? doc->records[index].tag : SymbolTable::kNoSymbol;
+}
+
+/** Function to Get the Value of the Node.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+Utilities::StringSpan NodeHandle::Value() const {
+	if (!IsValid())
+		return Utilities::StringSpan();
+	const FlatNode & node = doc->records[index];
+	return Utilities::StringSpan(doc->heap.data() + node.value, node.valueLength);
+}
+
+/** Function to Get the Number of Attributes of the Node.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+size_t NodeHandle::AttributeCount() const {
+	return IsValid() ? doc->records[index].attributeCount : 0;
+}
+
+/** Function to Get the Name of Attribute i of the Node.
+  *
+  * Dependant Function(s) - SymbolTable::Name
+  *
+  * Ver : 1.1
+  *		- The Name is Read From the SymbolTable.
+  * Ver : 1.0
+  *		- First Release.
+  */
+Utilities::StringSpan NodeHandle::AttributeName(size_t i) const {
+	if (i >= AttributeCount())
+		return Utilities::StringSpan();
+	const FlatAttribute & attribute = doc->attributeRecords[doc->records[index].firstAttribute + i];
+	return Utilities::StringSpan(doc->symbols->Name(attribute.name));
+}
+
+/** Function to Get the Value of Attribute i of the Node.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+Utilities::StringSpan NodeHandle::AttributeValue(size_t i) const {
+	if (i >= AttributeCount())
+		return Utilities::StringSpan();
+	const FlatAttribute & attribute = doc->attributeRecords[doc->records[index].firstAttribute + i];
+	return Utilities::StringSpan(doc->heap.data() + attribute.value, attribute.valueLength);
+}
+
+/** Function to Get the Parent of the Node (Invalid For the Root).
+  *
+  * Dependant Function(s) - FlatDocument::getNode
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+NodeHandle NodeHandle::Parent() const {
+	return IsValid() ? doc->getNode(doc->records[index].parent) : NodeHandle();
+}
+
+/** Function to Get the First Child of the Node (Invalid if it Has None).
+  *
+  * Dependant Function(s) - FlatDocument::getNode
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+NodeHandle NodeHandle::FirstChild() const {
+	return IsValid() ? doc->getNode(doc->records[index].firstChild) : NodeHandle();
+}
+
+/** Function to Get the Next Sibling of the Node (Invalid For the Last
+  * Child).
+  *
+  * Dependant Function(s) - FlatDocument::getNode
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+NodeHandle NodeHandle::NextSibling() const {
+	return IsValid() ? doc->getNode(doc->records[index].nextSibling) : NodeHandle();
+}
+
+/** Function to Get All the Children of the Node (Like Node::children).
+  *
+  * Dependant Function(s) - FlatDocument::getDescendants
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<NodeHandle> NodeHandle::Children() const {
+	if (!IsValid())
+		return std::vector<NodeHandle>();
+	return doc->getDescendants(*this);
+}
+
+/** Function to Copy the Node and its Subtree Into Nodes Made by xDoc, For
+  * Code Which Works on Node*. The Returned Node is Owned by xDoc But Not Yet
+  * Part of its Tree (Add it With AddChild / AppendChild).
+  *
+  * Dependant Function(s) - XMLDocument::CreateNode, FlatDocument::Materialize
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+Node * NodeHandle::ToNode(XMLDocument & xDoc) const {
+	if (!IsValid())
+		return nullptr;
+	Node * node = xDoc.CreateNode();
+	doc->Materialize(index, node, xDoc);
+	return node;
+}
+
+/** Function to Display All Node Information (Like Node::ShowInfo).
+  *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-XMLDocument::XMLDocument(bool verbose, std::string _version, std::string _encoding) {
-	SetVerbose(verbose);
+void NodeHandle::ShowInfo() const {
+	std::stringstream ss;
+	ss << "\n Node Info";
+	ss << "\n ---------";
+	ss << "\n [Tag]\t\t: " << Tag().str();
+	ss << "\n [Value]\t: " << Value().str();
+	ss << "\n [Attributes]\t: ";
+	for (size_t i = 0; i < AttributeCount(); i++) {
+		ss << "\n   --" << AttributeName(i).str() << "\t- " << AttributeValue(i).str();
+	}
+	ss << "\n Children Count : " << Children().size();
+	std::cout << ss.str();
+}
+
+/** Constructor For FlatDocument Class. The Document Holds Only the Root
+  * and Has a SymbolTable of its Own.
+  *
+  * Dependant Function(s) - FlatDocument::Clear
+  *
+  * Ver : 1.1
+  *		- Makes its Own SymbolTable.
+  * Ver : 1.0
+  *		- First Release.
+  */
+FlatDocument::FlatDocument(std::string _version, std::string _encoding) : symbols(new SymbolTable()) {
 	version = _version;
 	encoding = _encoding;
+	Clear();
+}
 
-	// Root element, will be used only for reference.
-	// Will not be present in XML when writing to a Document.
-	root = new Node;
-	root->value = "root";
+/** Constructor For FlatDocument Class Which Interns its Names in _symbols
+  * (Shared With Other Documents). A Null _symbols Makes a Table of its Own.
+  *
+  * Dependant Function(s) - FlatDocument::Clear
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+FlatDocument::FlatDocument(std::shared_ptr<SymbolTable> _symbols, std::string _version, std::string _encoding)
+	: symbols(_symbols ? _symbols : std::make_shared<SymbolTable>()) {
+	version = _version;
+	encoding = _encoding;
+	Clear();
 }
 
-/** Method to Set the VERBOSE Variable.
-  * VERBOSE = True  (Enables Verbose Mode)
-  * VERBOSE = False (Disables Verbose Mode)
+/** Constructor For FlatDocument Class Which Copies an XMLDocument (Headers,
+  * Nodes, Values & Attributes). Lazy Values are Decoded on the Way. Names
+  * are Interned in _symbols, or a Table of its Own When it is Null.
   *
-  * Dependant Function(s) - N/A
+  * Dependant Function(s) - FlatDocument::Flatten
   *
+  * Ver : 1.1
+  *		- Takes the SymbolTable to Intern Names in.
   * Ver : 1.0
   *		- First Release.
   */
-void XMLDocument::SetVerbose(bool verbose) {
-	VERBOSE = verbose;
-	if (VERBOSE)
-		std::cout << "\n [VERBOSE] : Verbose Mode Turned On for XMLDocument";
+FlatDocument::FlatDocument(XMLDocument & xDoc, std::shared_ptr<SymbolTable> _symbols)
+	: symbols(_symbols ? _symbols : std::make_shared<SymbolTable>()) {
+	Flatten(xDoc);
 }
 
-/** Function to Create An XML Node. This Function Creates 
-  * Node Without Any Arrtibutes And Children.
+/** Function to Empty the Document, Leaving the Root as the Only (and Open)
+  * Node. Headers and the SymbolTable are Kept, and so is the Memory of the
+  * Arrays and Heap.
   *
-  * Dependant Function(s) - N/A
+  * Dependant Function(s) - FlatDocument::Store, FlatDocument::Intern
   *
+  * Ver : 1.1
+  *		- The Root's (Empty) Tag is Interned.
   * Ver : 1.0
   *		- First Release.
   */
-Node * XMLDocument::CreateNode(std::string _tag, std::string _value) {
-	Node * newNode = new Node;
-	newNode->tag = _tag;
-	newNode->value = _value;
-	return newNode;
+void FlatDocument::Clear() {
+	records.clear();
+	attributeRecords.clear();
+	heap.clear();
+	openNodes.clear();
+	lastChildren.clear();
+	full = false;
+
+	// Root element, will be used only for reference (as in XMLDocument).
+	FlatNode root = { kNoNode, kNoNode, kNoNode, kNoNode, Intern(Utilities::StringSpan()), 0, 0, 0, 0 };
+	Store("root", 4, root.value, root.valueLength);
+	records.push_back(root);
+	openNodes.push_back(0);
+	lastChildren.push_back(kNoNode);
 }
 
-/** Function to Add Arrtibute to A Node.
+/** Function to Set Aside Room For nodeCount Nodes and heapBytes of Text.
   *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-void XMLDocument::AddAttribute(Node* _node, std::string _attribute, std::string _value) {
-	if (_node == nullptr) {
-		std::cout << "\n [Error] # Invalid Node";
-		return;
-	}
-	for (std::pair<std::string, std::string> att : _node->attributes) {
-		if (att.first == _attribute) {
-			std::cout << "\n [WARNING] : Attribute already Exists. Not adding same attribute again";
-			return;
-		}
-	}
-	_node->attributes.push_back(std::make_pair(_attribute, _value));
+void FlatDocument::Reserve(size_t nodeCount, size_t heapBytes) {
+	records.reserve(nodeCount);
+	heap.reserve(heapBytes);
 }
 
-/** Function to Add Child Node to The Root Node.
+/** Function to Append Text to the String Heap. Gives its Offset & Length,
+  * or an Empty String if the Heap Would Outgrow 32 Bit Offsets (Which
+  * Marks the Document as Full).
   *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-void XMLDocument::AddChild(Node * _node) {
-	for (Node * child : root->children) {
-		if (child == _node) {
-			std::cout << "\n [WARNING] : The node has already been added to XML";
-			return;
-		}
+void FlatDocument::Store(const char * data, size_t length, uint32_t & offset, uint32_t & stored) {
+	offset = stored = 0;
+	if (length > kNoNode - heap.size()) {
+		full = true;
+		return;
 	}
-	root->children.push_back(_node);
+	offset = (uint32_t)heap.size();
+	stored = (uint32_t)length;
+	heap.append(data, length);
 }
 
-/** Function to Add Child to A Specific Node.
-  * (Method Overload)
-  * 
-  * Dependant Function(s) - N/A
+/** Function to Get the Id of a Name in the SymbolTable, Adding it if
+  * Needed. Marks the Document as Full When the Table Cannot Take More
+  * Names (the Name is Then Read as the Empty One).
+  *
+  * Dependant Function(s) - SymbolTable::Intern
   *
   * Ver : 1.0
   *		- First Release.
   */
-void XMLDocument::AddChild(Node * _child, Node * _parent) {
-	if (_parent == nullptr)
-		_parent = root;
-	for (Node * child : _parent->children) {
-		if (child == _child) {
-			std::cout << "\n [WARNING] : The node has already been added to XML";
-			return;
-		}
-	}
-	_parent->children.push_back(_child);
+uint32_t FlatDocument::Intern(const Utilities::StringSpan & name) {
+	uint32_t id = symbols->Intern(name);
+	if (id != SymbolTable::kNoSymbol)
+		return id;
+	full = true;
+	return symbols->Intern(Utilities::StringSpan());
 }
 
-/** Function to Remove Each Node in the XML Structure (Tree).
-  * This Function will is Intended to Prevent Memory Loss Issues.
+/** Function to Add a Node as the Last Child of the Innermost Open Node and
+  * Open it. Returns its Index, or kNoNode if the Document is Full.
   *
-  * Dependant Function(s) - N/A
+  * Dependant Function(s) - FlatDocument::Intern
   *
+  * Ver : 1.1
+  *		- The Tag is Interned.
   * Ver : 1.0
   *		- First Release.
   */
-void CleanUpHelper(Node * _root) {
-	if (_root->children.size() != 0) {
-		while (!_root->children.empty()) {
-			Node * node = _root->children.back();
-			_root->children.pop_back();
-			CleanUpHelper(node);
-		}
-	}
-	else {
-		delete _root;
+uint32_t FlatDocument::OpenNode(const Utilities::StringSpan & _tag) {
+	if (records.size() >= kNoNode || attributeRecords.size() >= kNoNode) {
+		full = true;
+		return kNoNode;
 	}
+	uint32_t index = (uint32_t)records.size();
+	uint32_t parent = openNodes.back();
+	FlatNode node = { parent, kNoNode, kNoNode, kNoNode, Intern(_tag), 0, 0, (uint32_t)attributeRecords.size(), 0 };
+	records.push_back(node);
+
+	if (lastChildren.back() == kNoNode)
+		records[parent].firstChild = index;
+	else
+		records[lastChildren.back()].nextSibling = index;
+	lastChildren.back() = index;
+	openNodes.push_back(index);
+	lastChildren.push_back(kNoNode);
+	return index;
 }
-/** Function to Get All the Child Elements of a Specific Node.
-  * 
-  * Dependant Function(s) - N/A
+
+/** Function to Add an Attribute to the Innermost Open Node. Attributes are
+  * Only Taken Right After OpenNode (Before the Node Has Children), so Those
+  * of a Node Stay Next to Each Other; Returns False Otherwise.
   *
+  * Dependant Function(s) - FlatDocument::Intern, FlatDocument::Store
+  *
+  * Ver : 1.1
+  *		- The Name is Interned.
   * Ver : 1.0
   *		- First Release.
   */
-std::vector<Node *> XMLDocument::getDescendants(const Node * _node) {
-	std::vector<Node *> result;
-	if (_node == nullptr)
-		return result;
-	for (Node * child : _node->children) {
-		result.push_back(child);
+bool FlatDocument::AddAttribute(const Utilities::StringSpan & _name, const Utilities::StringSpan & _value) {
+	FlatNode & node = records[openNodes.back()];
+	if (node.firstAttribute + node.attributeCount != attributeRecords.size())
+		return false;
+	if (attributeRecords.size() >= kNoNode) {
+		full = true;
+		return false;
 	}
-	return result;
+	FlatAttribute attribute;
+	attribute.name = Intern(_name);
+	Store(_value.data, _value.length, attribute.value, attribute.valueLength);
+	attributeRecords.push_back(attribute);
+	node.attributeCount++;
+	return true;
 }
 
-/** Default Destructor for XMLDocument Class.
-  * Deletes All the Node(s) associated with XML Structure (Tree).
-  * 
-  * Dependant Function(s) - XMLDocument::CleanUpHelper
+/** Function to Set (Replace) the Value of the Innermost Open Node.
+  *
+  * Dependant Function(s) - FlatDocument::Store
   *
   * Ver : 1.0
   *		- First Release.
   */
-XMLDocument::~XMLDocument() {
-	if (VERBOSE)
-		std::cout << "\n [VERBOSE] : Destroying All the Nodes";
-	CleanUpHelper(root);
+void FlatDocument::SetValue(const Utilities::StringSpan & _value) {
+	FlatNode & node = records[openNodes.back()];
+	Store(_value.data, _value.length, node.value, node.valueLength);
 }
 
-/** Function to Display All Node Information.
-  * 
-  * Dependant Function(s) - Node::ShowInfo
+/** Function to Close the Innermost Open Node. Returns False When Only the
+  * Root is Open (the Root is Never Closed).
+  *
+  * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-void XMLDocument::ShowNode(Node * node) {
-	node->ShowInfo();
+bool FlatDocument::CloseNode() {
+	if (openNodes.size() <= 1)
+		return false;
+	records[openNodes.back()].subtreeEnd = (uint32_t)records.size();
+	openNodes.pop_back();
+	lastChildren.pop_back();
+	return true;
 }
 
-std::string XMLDocument::ShowXMLTree(bool print) {
-	std::string result;
-	ShowXMLTreeHelper(result, root, 0);
-	if (print)
-		std::cout << result;
-	return result;
+/** Function to Get the Innermost Open Node (the Root When No Other Node is
+  * Open).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+NodeHandle FlatDocument::getOpenNode() const {
+	return NodeHandle(this, openNodes.back());
 }
 
-/** Function to Display XML Structure(Tree) Similar to
-  * Output of Tree Command in Windows/Linux
-  * Does not Display Attributes.
-  * 
+/** Function to Get the End of the Subtree of a Node (One Past its Last
+  * Descendant). Nodes Still Open End at the End of the Array.
+  *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-void XMLDocument::ShowXMLTreeHelper(std::string & tree, Node * node, int indent) {
-	tree.push_back('\n');
-	tree.push_back('|');
-	if (indent != 0) {
-		int last = indent - 1;
-		for (int i = 0; i < indent; i++) {
-			if (i == last) {
-				if (i != 0) {
-					tree.push_back('|');
-					tree.append("-----");
-				}
-				else {
-					tree.append("-----");
-				}
-			} else
-				tree.push_back('\t');
-		}
-	} 
+uint32_t FlatDocument::SubtreeEnd(uint32_t index) const {
+	uint32_t end = records[index].subtreeEnd;
+	return end == kNoNode ? (uint32_t)records.size() : end;
+}
 
-	tree.append(std::string("[" + node->tag + "] : "));
-	if (node->value == "")
-		tree.append("N/A");
-	else
-		tree.append(node->value);
+/** Function to Replace the Document With a Copy of xDoc, Walking its Tree
+  * in Document Order With an Explicit Stack (Deep Documents Cannot Overflow
+  * the Call Stack).
+  *
+  * Dependant Function(s) - FlatDocument::Clear, FlatDocument::OpenNode,
+  *		FlatDocument::AddAttribute, FlatDocument::SetValue,
+  *		FlatDocument::CloseNode, Node::GetValue, Node::GetAttributes
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void FlatDocument::Flatten(XMLDocument & xDoc) {
+	version = xDoc.getVersion();
+	encoding = xDoc.getEncoding();
+	Clear();
 
-	if (node->children.size() != 0) {
-		for (size_t i = 0; i < node->children.size(); i++) {
-			ShowXMLTreeHelper(tree, node->children[i], indent + 1);
+	std::vector<std::pair<Node *, size_t>> pending(1, std::make_pair(xDoc.getRoot(), (size_t)0));
+	while (!pending.empty()) {
+		Node * node = pending.back().first;
+		size_t next = pending.back().second;
+		if (next == node->children.size()) {
+			pending.pop_back();
+			if (!pending.empty())
+				CloseNode();
+			continue;
 		}
+		pending.back().second++;
+		Node * child = node->children[next];
+		if (OpenNode(child->tag) == kNoNode)
+			return;
+		for (std::pair<std::string, std::string> & attribute : child->GetAttributes())
+			AddAttribute(attribute.first, attribute.second);
+		SetValue(child->GetValue());
+		pending.push_back(std::make_pair(child, (size_t)0));
 	}
 }
 
-/** Function to Perform A Query On XML to Get All Elements With A Specific
-  * Tag Name.
+/** Function to Fill target With Node index and Add the Rest of its Subtree
+  * Below it as Nodes Made by xDoc. Nodes Come in Document Order, so a
+  * Node's Parent is Always Made Before it.
   *
-  * Dependant Function(s) - XMLDocument::getElementByTagHelper
+  * Dependant Function(s) - XMLDocument::CreateNode, XMLDocument::AppendChild,
+  *		SymbolTable::Name
   *
+  * Ver : 1.1
+  *		- Names are Read From the SymbolTable.
   * Ver : 1.0
   *		- First Release.
   */
-std::vector<Node *> XMLDocument::getElementByTag(const std::string & _tagName) {
-	std::vector<Node *> results;
-	getElementByTagHelper(results, root, _tagName);
-	return results;
+void FlatDocument::Materialize(uint32_t index, Node * target, XMLDocument & xDoc) const {
+	uint32_t end = SubtreeEnd(index);
+	std::vector<Node *> made(end - index, nullptr);
+	for (uint32_t i = index; i < end; i++) {
+		const FlatNode & record = records[i];
+		Node * node = i == index ? target : xDoc.CreateNode();
+		node->tag = symbols->Name(record.tag);
+		node->SetValue(std::string(heap.data() + record.value, record.valueLength));
+		for (uint32_t a = record.firstAttribute; a < record.firstAttribute + record.attributeCount; a++) {
+			const FlatAttribute & attribute = attributeRecords[a];
+			node->attributes.emplace_back(std::piecewise_construct,
+				std::forward_as_tuple(symbols->Name(attribute.name)),
+				std::forward_as_tuple(heap.data() + attribute.value, attribute.valueLength));
+		}
+		if (i != index)
+			xDoc.AppendChild(node, made[record.parent - index]);
+		made[i - index] = node;
+	}
 }
 
-/** Helper Function For GetElementByTag Function.
+/** Function to Copy the Document Into a New XMLDocument (Owned by the
+  * Caller).
   *
-  * Dependant Function(s) - N/A
+  * Dependant Function(s) - FlatDocument::Materialize
   *
   * Ver : 1.0
   *		- First Release.
   */
-void XMLDocument::getElementByTagHelper(std::vector<Node *> &vec, Node * node, const std::string & _tagname) {
-	if (node == nullptr) {
-		return;
-	}
-
-	if (node != root && node->tag == _tagname) {
-		vec.push_back(node);
-	}
+XMLDocument * FlatDocument::ToXMLDocument() const {
+	XMLDocument * xDoc = new XMLDocument(false, version, encoding);
+	Materialize(0, xDoc->getRoot(), *xDoc);
+	return xDoc;
+}
 
-	if (!node->children.empty()) {
-		for (Node * child : node->children) {
-			getElementByTagHelper(vec, child, _tagname);
-		}
-	}
+/** Function to Get the Bytes the Document Holds (Arrays and Heap, Counting
+  * Reserved Room). The SymbolTable, Which May be Shared, is Not Counted
+  * (See SymbolTable::MemoryUsage).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+size_t FlatDocument::MemoryUsage() const {
+	return sizeof(FlatDocument) + records.capacity() * sizeof(FlatNode)
+		+ attributeRecords.capacity() * sizeof(FlatAttribute) + heap.capacity()
+		+ (openNodes.capacity() + lastChildren.capacity()) * sizeof(uint32_t);
 }
 
 /** Function to Perform A Query On XML to Get All Elements With A Specific
-  * Value.
+  * Tag Name, in Document Order. The Name is Looked Up Once in the
+  * SymbolTable (a Name Which is Not There Matches Nothing), Then the Node
+  * Array is Swept Comparing Ids.
   *
-  * Dependant Function(s) - XMLDocument::getElementByValueHelper
+  * Dependant Function(s) - SymbolTable::Find, FlatDocument::getElementByTagId
   *
+  * Ver : 1.1
+  *		- Compares Symbol Ids Instead of Strings.
   * Ver : 1.0
   *		- First Release.
   */
-std::vector<Node *> XMLDocument::getElementByValue(const std::string & _value) {
-	std::vector<Node *> results;
-	getElementByValueHelper(results, root, _value);
-	return results;
+std::vector<NodeHandle> FlatDocument::getElementByTag(const std::string & _tagName) const {
+	uint32_t tagId = symbols->Find(_tagName);
+	if (tagId == SymbolTable::kNoSymbol)
+		return std::vector<NodeHandle>();
+	return getElementByTagId(tagId);
 }
 
-/** Helper Function For GetElementByValue.
+/** Function to Get All Elements Whose Tag Has a Given Id in the Document's
+  * SymbolTable, in Document Order. One Pass Over the Node Array.
   *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-void XMLDocument::getElementByValueHelper(std::vector<Node *> &vec, Node * node, const std::string & _value) {
-	if (node == nullptr) {
-		return;
+std::vector<NodeHandle> FlatDocument::getElementByTagId(uint32_t _tagId) const {
+	std::vector<NodeHandle> results;
+	for (uint32_t i = 1; i < records.size(); i++) {
+		if (records[i].tag == _tagId)
+			results.push_back(NodeHandle(this, i));
 	}
+	return results;
+}
 
-	if (node != root && node->value == _value) {
-		vec.push_back(node);
+/** Function to Perform A Query On XML to Get All Elements With A Specific
+  * Value, in Document Order (a Linear Sweep, Like getElementByTag).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<NodeHandle> FlatDocument::getElementByValue(const std::string & _value) const {
+	std::vector<NodeHandle> results;
+	const char * pHeap = heap.data();
+	size_t length = _value.size();
+	for (uint32_t i = 1; i < records.size(); i++) {
+		const FlatNode & node = records[i];
+		if (node.valueLength == length && std::memcmp(pHeap + node.value, _value.data(), length) == 0)
+			results.push_back(NodeHandle(this, i));
 	}
+	return results;
+}
 
-	if (!node->children.empty()) {
-		for (Node * child : node->children) {
-			getElementByValueHelper(vec, child, _value);
-		}
-	}
+/** Function to Get All the Child Elements of a Specific Node (Like
+  * XMLDocument::getDescendants).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<NodeHandle> FlatDocument::getDescendants(const NodeHandle & _node) const {
+	std::vector<NodeHandle> result;
+	if (_node.doc != this || !_node.IsValid())
+		return result;
+	for (uint32_t i = records[_node.index].firstChild; i != kNoNode; i = records[i].nextSibling)
+		result.push_back(NodeHandle(this, i));
+	return result;
 }
 
 /** Function to Get XML Version.
@@ -313,11 +1982,10 @@ void XMLDocument::getElementByValueHelper(std::vector<Node *> &vec, Node * node,
   * Ver : 1.0
   *		- First Release.
   */
-std::string XMLDocument::getVersion() {
+std::string FlatDocument::getVersion() const {
 	return version;
 }
 
-
 /** Function to Set XML Version.
   *
   * Dependant Function(s) - N/A
@@ -325,11 +1993,10 @@ std::string XMLDocument::getVersion() {
   * Ver : 1.0
   *		- First Release.
   */
-void XMLDocument::setVersion(std::string & _version) {
+void FlatDocument::setVersion(const std::string & _version) {
 	version = _version;
 }
 
-
 /** Function to Get XML Encoding.
   *
   * Dependant Function(s) - N/A
@@ -337,7 +2004,7 @@ void XMLDocument::setVersion(std::string & _version) {
   * Ver : 1.0
   *		- First Release.
   */
-std::string XMLDocument::getEncoding() {
+std::string FlatDocument::getEncoding() const {
 	return encoding;
 }
 
@@ -348,19 +2015,30 @@ std::string XMLDocument::getEncoding() {
   * Ver : 1.0
   *		- First Release.
   */
-void XMLDocument::setEncoding(std::string & _encoding) {
+void FlatDocument::setEncoding(const std::string & _encoding) {
 	encoding = _encoding;
 }
 
-/** Function to Get Root Element of XML.
-  * 
+/** Function to Get Root Element of XML (Node 0).
+  *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-Node * XMLDocument::getRoot() {
-	return root;
+NodeHandle FlatDocument::getRoot() const {
+	return NodeHandle(this, 0);
+}
+
+/** Function to Get Node index (Invalid if There is No Such Node).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+NodeHandle FlatDocument::getNode(uint32_t index) const {
+	return index < records.size() ? NodeHandle(this, index) : NodeHandle();
 }
 
 #ifdef TEST_XML_DOCUMENT
@@ -462,7 +2140,65 @@ int main() {
 	else {
 		std::cout << "\n No elements with Value : Action were found in the XDocument\n";
 	}
-	
+	std::cout << "\n";
+
+	StringHelper::Title("Query Through the Tag Index");
+	xDoc->SetTagIndex(true);
+	std::cout << "\n Actor Elements : " << xDoc->getElementByTag("Actor").size()
+		<< " (Index Built by the Query, " << xDoc->TagIndexMemoryUsage() << " Bytes)";
+	Node * node8 = xDoc->CreateNode("Actor", "Billy Dee Williams");
+	xDoc->AddChild(node8, node1);
+	std::cout << "\n After Adding One : " << xDoc->getElementByTag("Actor").size()
+		<< ", the Last Being " << xDoc->getElementByTag("Actor").back()->GetValue();
+	xDoc->RemoveChild(node8, node1);
+	std::cout << "\n After Removing it : " << xDoc->getElementByTag("Actor").size();
+	xDoc->SetTag(node7, "Actor");
+	std::cout << "\n After Renaming Node 7 : " << xDoc->getElementByTag("Actor").size();
+	xDoc->SetTag(node7, "Node");
+	xDoc->SetTagIndex(false);
+	std::cout << "\n\n";
+
+	StringHelper::Title("Query Through the Value Index");
+	xDoc->BuildValueIndex();
+	std::cout << "\n Elements with Value Action : " << xDoc->getElementByValue("Action").size()
+		<< " (" << xDoc->ValueIndexMemoryUsage() << " Bytes)";
+	std::cout << "\n Elements with Value action (Ignoring Case) : " << xDoc->getElementByValueIgnoreCase("action").size();
+	std::cout << "\n Elements with Value Starting With Star : " << xDoc->getElementByValuePrefix("Star").size();
+	xDoc->SetValue(node2, "Adventure");
+	std::cout << "\n After Changing Node 2 : " << xDoc->getElementByValue("Action").size() << " Action, "
+		<< xDoc->getElementByValuePrefix("ad", true).size() << " Starting With ad (Ignoring Case)";
+	xDoc->SetValue(node2, "Action");
+	xDoc->SetValueIndex(false);
+	std::cout << "\n\n";
+
+	StringHelper::Title("Flatten the Document (FlatDocument)");
+	FlatDocument flat(*xDoc);
+	std::cout << "\n Flattened " << flat.getNodeCount() - 1 << " Nodes Into " << flat.MemoryUsage() << " Bytes";
+	std::cout << "\n Names Interned : " << flat.getSymbols()->Count() << " (Actor is Symbol "
+		<< flat.getSymbols()->Find("Actor") << ")";
+	std::cout << "\n Elements with Actor Tag Name are : ";
+	for (const NodeHandle & handle : flat.getElementByTag("Actor")) {
+		handle.ShowInfo();
+		std::cout << "\n";
+	}
+	NodeHandle movie = flat.getRoot().FirstChild();
+	std::cout << "\n " << movie.Tag().str() << " Has " << movie.Children().size() << " Children, the Last Being "
+		<< movie.Children().back().Value().str();
+	XMLDocument * copy = flat.ToXMLDocument();
+	std::cout << "\n Copied Back to an XMLDocument : " << (copy->ShowXMLTree() == xDoc->ShowXMLTree() ? "Same Tree" : "Different Tree");
+	delete copy;
+	std::cout << "\n\n";
+
+	StringHelper::Title("Create Nodes in the Document's Arena");
+	XMLDocument * arenaDoc = new XMLDocument();
+	for (int i = 0; i < 100000; i++)
+		arenaDoc->AppendChild(arenaDoc->CreateNode("Item", std::to_string(i)), nullptr);
+	std::cout << "\n Created " << arenaDoc->getRoot()->children.size() << " Nodes With CreateNode";
+	std::cout << "\n Last Node Value : " << arenaDoc->getRoot()->children.back()->GetValue();
+	delete arenaDoc;
+	delete xDoc;
+	std::cout << "\n Destroyed Both Documents\n";
+
 	time.End();
 
 	std::cout << "\n";
@@ -1,6 +1,6 @@
 //////////////////////////////////////////////////////////////////////
 // XMLDocument.h	:	Create in-Memory XML Like Structure.		//
-// Version			:	2.0											//
+// Version			:	2.10										//
 // -----------------------------------------------------------------//
 // Copyright  Venkata Chekuri, 2016								//
 // All rights granted provided that this notice is retained.		//
@@ -27,12 +27,88 @@
  * like Version & Encoding. There are also methods present in this class which
  * allows the user to Query XML.
  *
+ * NodeArena is the Slab Allocator the XMLDocument Takes its Nodes From.
+ *
+ * FlatDocument is a Compact Alternative to XMLDocument : its Nodes (FlatNode)
+ * Lie in One Array in Document Order, Linked by 32 Bit Parent / First Child
+ * / Next Sibling Indices, and Their Text Lies in One Shared String Heap.
+ * A NodeHandle Reads a Node of a FlatDocument the Way a Node* Reads a Node,
+ * and Can Turn it Back Into Nodes of an XMLDocument. Tag and Attribute Names
+ * of a FlatDocument are Kept Once in a SymbolTable (Which Documents Can
+ * Share); its Nodes Only Hold Their Symbol Ids.
+ *
  * DEPENDANT FILES
  * ---------------
  * XMLDocument.h, XMLDocument.cpp, Utilities.h, Utilities.cpp
  *
  * CHANGELOG
  * ---------
+ * Ver 2.10 : 10/18/2026
+ *	- The Value Index Uses the Same Stamps : SetValue to a Value Other Nodes
+ *	  Have and Subtrees Added Anywhere No Longer Make it Stale.
+ *
+ * Ver 2.9 : 10/18/2026
+ *	- Nodes Carry Gapped Document Order Stamps (Node::order, orderEnd), so
+ *	  the Tag Index Stays Current Under SetTag and Subtrees Added Anywhere
+ *	  in the Document : Their Nodes are Put in Place by Binary Search.
+ *
+ * Ver 2.8 : 10/18/2026
+ *	- Turning One Index Off No Longer Frees the Path to the Last Node While
+ *	  the Other Index is Current (Which Made it Go Stale on the Next Add).
+ *
+ * Ver 2.7 : 10/18/2026
+ *	- Added an Optional Value Index (SetValueIndex / BuildValueIndex) : a
+ *	  Hash From Each Value to its Nodes in Document Order Answers
+ *	  getElementByValue Without Walking the Tree, and an Ordered Set of the
+ *	  Values (Built on the First Such Query) Answers the New
+ *	  getElementByValuePrefix and getElementByValueIgnoreCase. Kept Up to
+ *	  Date Like the Tag Index; Values Changed With the New SetValue Move
+ *	  Between Lists in Place. ValueIndexMemoryUsage Reports What it Costs.
+ *
+ * Ver 2.6 : 10/18/2026
+ *	- Added an Optional Tag Index (SetTagIndex / BuildTagIndex) : For Each
+ *	  Tag, its Nodes in Document Order, so getElementByTag Costs O(Matches)
+ *	  Instead of a Walk Over the Whole Tree. Nodes Added at the End of the
+ *	  Document (Builders, AddChild Under the Last Open Path) are Indexed as
+ *	  They are Added and RemoveChild Takes Nodes Out; Other Changes Make the
+ *	  Index Rebuild Itself on the Next Query. TagIndexMemoryUsage Reports
+ *	  What it Costs.
+ *	- Added RemoveChild, SetTag and InvalidateIndexes.
+ *
+ * Ver 2.5 : 10/18/2026
+ *	- Added SymbolTable : FlatDocument Interns Tag and Attribute Names (Each
+ *	  Name Kept Once Per Table, Which Several Documents Can Share), so a
+ *	  FlatNode Holds a Symbol Id Instead of an Offset & Length Into the Heap
+ *	  (36 Bytes; 12 Per Attribute) and getElementByTag Compares Integers.
+ *	  Added getElementByTagId & NodeHandle::TagId.
+ *
+ * Ver 2.4 : 10/18/2026
+ *	- Added FlatDocument, FlatNode, FlatAttribute and NodeHandle : Nodes in
+ *	  One Array in Document Order (40 Bytes Each Instead of Two Strings and
+ *	  Two Vectors), Text in One String Heap. Tag & Value Queries are a
+ *	  Linear Sweep of the Array With No Pointer Hops. A FlatDocument is Made
+ *	  From an XMLDocument (or Built Directly, See FlatBuilder in
+ *	  XMLFileProcessor) and Turned Back Into One With ToXMLDocument.
+ *
+ * Ver 2.3 : 10/18/2026
+ *	- Nodes Made by the Document (CreateNode, the Root, Builders) are Taken
+ *	  From a NodeArena it Owns : Slabs of Nodes Filled in Order, so a Node
+ *	  Costs a Pointer Increment and a Subtree Built in Document Order Lies
+ *	  in One Run of Memory. The Destructor Sweeps the Slabs and Frees Each
+ *	  Slab Once Instead of Deleting Node by Node.
+ *	- Fixed the Destructor Leaking Every Node Which Had Children (Nodes
+ *	  Added With AddChild / AppendChild Which Were Not Made by the Document
+ *	  are Still Deleted With it).
+ *
+ * Ver 2.2 : 10/18/2026
+ *	- Added Lazy Values : a Node Can Keep its Value and Attribute Values as
+ *	  Undecoded Text in the Input (Kept Alive by a RawSource Owned by the
+ *	  XMLDocument). They are Decoded on First Read (Node::GetValue,
+ *	  Node::GetAttributes) and Cached.
+ *
+ * Ver 2.1 : 10/18/2026
+ *	- Added AppendChild (Add Without the Duplicate Check, For Builders).
+ *
  * Ver 2.0 : 01/10/2017
  *	- Added Support For VERBOSE Mode.
  *
@@ -43,18 +119,51 @@
 #ifndef XML_DOCUMENT_H
 #define XML_DOCUMENT_H
 
+#include "../Utilities/Utilities.h"
+
 #include <string>
+#include <set>
+#include <memory>
 #include <vector>
+#include <cstdint>
 #include <utility>
 #include <sstream>
 #include <iostream>
+#include <unordered_map>
+
+/** Interface to the Input a Lazily Built XMLDocument Was Read From. Keeps
+  * the Input Alive and Decodes Undecoded Text Taken From it.
+  *
+  * Dependant Class(es) or Structure(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+class RawSource {
+public:
+	virtual ~RawSource() {}
+	virtual void Decode(const char * data, size_t length, std::string & out) const = 0;
+};
 
 /** Structure to Hold The Basic XML Tag, Tag Attributes, Tag Value
   * and Pointers to Associated Child Elements.
   * Also Has a Method to Display All the Node Information.
+  * When the Node Was Built With Lazy Values the value and the Attribute
+  * Values are Still Undecoded in source (rawValue, rawAttributes[i] For
+  * attributes[i]); GetValue and GetAttributes Decode Them Once and Cache
+  * Them in value and attributes. Reading value or attributes Directly
+  * Only Sees What Has Been Decoded so Far. Not Thread Safe.
   * 
-  * Dependant Class(es) or Structure(s) - N/A
+  * order and orderEnd are Kept by the Indexes of the XMLDocument Holding
+  * the Node (See XMLDocument).
+  *
+  * Dependant Class(es) or Structure(s) - RawSource
   *
+  * Ver : 1.2
+  *		- Added order & orderEnd.
+  * Ver : 1.1
+  *		- Added Lazy Values (source, rawValue, rawAttributes, GetValue,
+  *		  GetAttributes & SetValue).
   * Ver : 1.0
   *		- First Release.
   */
@@ -64,14 +173,45 @@ struct Node {
 	std::vector<std::pair<std::string, std::string>> attributes;
 	std::vector<Node *> children;
 
+	const RawSource * source = nullptr;
+	const char * rawValue = nullptr;
+	size_t rawValueLength = 0;
+	std::vector<std::pair<const char *, size_t>> rawAttributes;
+
+	/* Place in Document Order, and the Place of the Node Following the Subtree */
+	uint64_t order = 0;
+	uint64_t orderEnd = 0;
+
+	const std::string & GetValue() {
+		if (rawValue != nullptr) {
+			source->Decode(rawValue, rawValueLength, value);
+			rawValue = nullptr;
+		}
+		return value;
+	}
+
+	std::vector<std::pair<std::string, std::string>> & GetAttributes() {
+		for (size_t i = 0; i < rawAttributes.size(); i++) {
+			if (rawAttributes[i].first != nullptr)
+				source->Decode(rawAttributes[i].first, rawAttributes[i].second, attributes[i].second);
+		}
+		rawAttributes.clear();
+		return attributes;
+	}
+
+	void SetValue(const std::string & _value) {
+		value = _value;
+		rawValue = nullptr;
+	}
+
 	void ShowInfo() {
 		std::stringstream ss;
 		ss << "\n Node Info";
 		ss << "\n ---------";
 		ss << "\n [Tag]\t\t: " << tag;
-		ss << "\n [Value]\t: " << value;
+		ss << "\n [Value]\t: " << GetValue();
 		ss << "\n [Attributes]\t: ";
-		for (std::pair<std::string, std::string> pr : attributes) {
+		for (std::pair<std::string, std::string> pr : GetAttributes()) {
 			ss << "\n   --" << pr.first << "\t- " << pr.second;
 		}
 		ss << "\n Children Count : " << children.size();
@@ -79,11 +219,89 @@ struct Node {
 	};
 };
 
+/** Class to Allocate Nodes in Slabs : Each Slab Holds Twice as Many Nodes
+  * as the One Before (Up to kMaxSlabNodes) and is Filled in Order, so New
+  * is a Pointer Increment and Nodes Made One After the Other are Next to
+  * Each Other in Memory. Nodes are Never Freed One by One; the Destructor
+  * Destroys Every Node Slab by Slab and Frees Each Slab Once. Not Thread
+  * Safe (Each Thread Builds in its Own Arena, Then Adopt Merges Them).
+  *
+  * Dependant Class(es) or Structure(s) - Node
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+class NodeArena {
+public:
+	NodeArena();
+	NodeArena(const NodeArena&) = delete;
+	NodeArena& operator=(const NodeArena&) = delete;
+	~NodeArena();
+
+	Node * New();
+	bool Owns(const Node * node) const;
+	void Adopt(NodeArena & other);
+	size_t Count() const { return count; }
+private:
+	/* Nodes in the First Slab, and the Most a Slab Ever Holds */
+	static const size_t kFirstSlabNodes = 16;
+	static const size_t kMaxSlabNodes = 64 * 1024;
+
+	struct Slab {
+		Node * nodes;
+		size_t used;
+		size_t capacity;
+	};
+	std::vector<Slab> slabs;
+	size_t count;
+};
+
 /** Class to Create XML Like Structure But in a Tree Like Format
   * so that Querying the XML is Faster and Easier.
   *
-  * Dependant Class(es) or Structure(s) - N/A
+  * With the Tag Index On, the Document Keeps Each Tag's Nodes in Document
+  * Order. Every Node is Stamped With its Place (Node::order, Counted in
+  * Steps of kOrderGap so Others Fit Between) and the Place of the Node
+  * After its Subtree (Node::orderEnd). A Subtree Added Under a Node Gets
+  * Stamps Between the Last Node Before it and its Parent's orderEnd (Taking
+  * Only a Small Share of That Room, so Many Adds at One Place Fit), and its
+  * Nodes are Put in Their Lists by Binary Search; SetTag Moves a Node
+  * Between Lists the Same Way. When no Stamps are Left the Parent's Subtree
+  * is Spread Over its Own Range, or Failing That the Whole Document is
+  * Renumbered. The Path From the Root to the Last
+  * Node (lastPath) is Kept so Builders, Which Add at the End, Find the Last
+  * Node Right Away. Changes Made to Nodes Directly (tag, children) are Not
+  * Seen Until InvalidateIndexes is Called (the Index is Then Rebuilt by
+  * the Next Query).
+  * Queries May Rebuild the Index, so Like Lazy Values They are Not Thread
+  * Safe.
+  *
+  * The Value Index Works the Same Way (Sharing lastPath and the Stamps),
+  * With a List Per Value. Its Ordered Set (valueOrder) Points at the Index's Entries and
+  * Sorts Them by ASCII Case Folded Value, Then Value, so the Values Which
+  * Match a Key or a Prefix Ignoring Case are Next to Each Other. Building
+  * it Decodes Every Lazy Value.
   *
+  * Dependant Class(es) or Structure(s) - NodeArena
+  *
+  * Ver : 2.7
+  *		- The Value Index is Kept Current the Same Way.
+  * Ver : 2.6
+  *		- The Tag Index is Kept Current Under SetTag and Adding Anywhere
+  *		  (Document Order Stamps, Renumber).
+  * Ver : 2.5
+  *		- Added the Value Index (SetValueIndex, BuildValueIndex,
+  *		  ValueIndexMemoryUsage), getElementByValuePrefix,
+  *		  getElementByValueIgnoreCase & SetValue.
+  * Ver : 2.4
+  *		- Added the Tag Index (SetTagIndex, BuildTagIndex, InvalidateIndexes,
+  *		  TagIndexMemoryUsage), RemoveChild & SetTag.
+  * Ver : 2.3
+  *		- Nodes Come From a NodeArena (CreateNode, AdoptNodes).
+  * Ver : 2.2
+  *		- Added setRawSource (Input Kept For Lazy Values).
+  * Ver : 2.1
+  *		- Added AppendChild.
   * Ver : 2.0
   *		- Added VERBOSE Mode.
   * Ver : 1.0
@@ -91,16 +309,58 @@ struct Node {
   */
 class XMLDocument {
 private:
+	NodeArena nodes;
+	bool foreignNodes;
 	Node * root;
+	RawSource * rawSource;
 	std::string version;
 	std::string encoding;
 	bool VERBOSE;
 
+	typedef std::pair<const std::string, std::vector<Node *>> ValueEntry;
+
+	/* Orders Value Index Entries by Case Folded Value, Then by Value */
+	struct FoldedLess {
+		bool operator()(const ValueEntry * a, const ValueEntry * b) const;
+	};
+
+	/* Distance Between Stamps After Renumber, the Stamp Past the Last Node,
+	   and the Share of the Room Left That a Node Added at a Tail Takes */
+	static const uint64_t kOrderGap = (uint64_t)1 << 32;
+	static const uint64_t kOrderEnd = (uint64_t)1 << 63;
+	static const uint64_t kOrderShare = 1024;
+
+	bool tagIndexOn;
+	bool tagIndexCurrent;
+	std::unordered_map<std::string, std::vector<Node *>> tagIndex;
+	bool valueIndexOn;
+	bool valueIndexCurrent;
+	bool valueOrderCurrent;
+	std::unordered_map<std::string, std::vector<Node *>> valueIndex;
+	std::set<const ValueEntry *, FoldedLess> valueOrder;
+	std::vector<Node *> lastPath;
+
+	void Attached(Node * _child, Node * _parent);
+	void IndexSubtree(Node * _node, bool tags, bool values);
+	void Stamp(Node * _node, uint64_t first, uint64_t step, uint64_t end);
+	void Renumber();
+	bool Indexed(Node * _node);
+	static std::vector<Node *>::iterator FindOrdered(std::vector<Node *> & list, Node * _node);
+	static void InsertOrdered(std::vector<Node *> & list, Node * _node);
+	void IndexValue(Node * _node);
+	void DropValue(std::unordered_map<std::string, std::vector<Node *>>::iterator entry);
+	void RebuildTagIndex();
+	void RebuildValueIndex();
+	void RebuildValueOrder();
+	std::vector<Node *> getElementByValueOrdered(const std::string & _key, bool prefix, bool ignoreCase);
 	void getElementByTagHelper(std::vector<Node *> &vec, Node * node, const std::string & _tagname);
-	void getElementByValueHelper(std::vector<Node *> &vec, Node * node, const std::string & _value);
+	void getElementByValueHelper(std::vector<Node *> &vec, Node * node, const std::string & _value,
+		bool prefix = false, bool ignoreCase = false);
 	void ShowXMLTreeHelper(std::string & tree, Node * _node, int indent = 0);
 public:
 	XMLDocument(bool verbose = false, std::string _version = "1.0", std::string _encoding = "UTF-8");
+	XMLDocument(const XMLDocument&) = delete;
+	XMLDocument& operator=(const XMLDocument&) = delete;
 	~XMLDocument();
 
 	// Methods associated with constructing XML
@@ -108,19 +368,223 @@ public:
 	void AddAttribute(Node* _node, std::string _attribute, std::string _value = "");
 	void AddChild(Node * _child, Node * _parent);
 	void AddChild(Node * _node);
+	void AppendChild(Node * _child, Node * _parent);
+	bool RemoveChild(Node * _child, Node * _parent);
+	void SetTag(Node * _node, const std::string & _tag);
+	void SetValue(Node * _node, const std::string & _value);
 	Node * CreateNode(std::string _tag, std::string _value);
+	Node * CreateNode();
+	void AdoptNodes(NodeArena & arena);
 	std::string ShowXMLTree(bool print = false);
 	void SetVerbose(bool verbose);
 
 	// Methods associated with querying XML
 	std::vector<Node *> getElementByTag(const std::string & _tagName);
 	std::vector<Node *> getElementByValue(const std::string & _value);
+	std::vector<Node *> getElementByValueIgnoreCase(const std::string & _value);
+	std::vector<Node *> getElementByValuePrefix(const std::string & _prefix, bool ignoreCase = false);
 	std::vector<Node *> getDescendants(const Node * _node);
+	void SetTagIndex(bool enabled);
+	void BuildTagIndex();
+	void InvalidateIndexes();
+	size_t TagIndexMemoryUsage() const;
+	void SetValueIndex(bool enabled);
+	void BuildValueIndex();
+	size_t ValueIndexMemoryUsage() const;
 
 	std::string getVersion();
 	void setVersion(std::string & _version);
 	std::string getEncoding();
 	void setEncoding(std::string & _encoding);
 	Node * getRoot();
+	void setRawSource(RawSource * _source);
+};
+
+class FlatDocument;
+
+/** Class to Intern Names : Each Distinct Name Gets a Small Integer Id (0,
+  * 1, 2.. in the Order They are First Seen) and is Kept Once, However Many
+  * Times it is Interned. Names Never Leave the Table, so Ids Stay Valid as
+  * Long as it Lives. Several Documents Can Share One Table (Through a
+  * std::shared_ptr) to Keep a Set of Similar Documents' Names Once and Give
+  * Them the Same Ids. Not Thread Safe.
+  *
+  * Dependant Class(es) or Structure(s) - StringSpan
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+class SymbolTable {
+public:
+	static const uint32_t kNoSymbol = 0xFFFFFFFF;
+
+	SymbolTable();
+	SymbolTable(const SymbolTable&) = delete;
+	SymbolTable& operator=(const SymbolTable&) = delete;
+
+	uint32_t Intern(const Utilities::StringSpan & name);
+	uint32_t Find(const std::string & name) const;
+	const std::string & Name(uint32_t id) const;
+	size_t Count() const { return names.size(); }
+	size_t MemoryUsage() const;
+private:
+	std::unordered_map<std::string, uint32_t> ids;
+	std::vector<const std::string *> names;
+	std::string key;
+};
+
+/** Structure For One Node of a FlatDocument (36 Bytes). parent, firstChild
+  * and nextSibling are Indices Into the Document's Node Array (kNoNode When
+  * There is None); the Node's Subtree is [Its Index, subtreeEnd). tag is
+  * the Id of the Tag Name in the Document's SymbolTable, value an Offset
+  * Into its String Heap and firstAttribute an Index Into its Attribute
+  * Array (the Node's Attributes are Next to Each Other There).
+  *
+  * Dependant Class(es) or Structure(s) - N/A
+  *
+  * Ver : 1.1
+  *		- tag is a Symbol Id (tagLength Removed).
+  * Ver : 1.0
+  *		- First Release.
+  */
+struct FlatNode {
+	uint32_t parent;
+	uint32_t firstChild;
+	uint32_t nextSibling;
+	uint32_t subtreeEnd;
+	uint32_t tag;
+	uint32_t value;
+	uint32_t valueLength;
+	uint32_t firstAttribute;
+	uint32_t attributeCount;
+};
+
+/** Structure For One Attribute of a FlatDocument Node. name is the Id of
+  * the Name in the Document's SymbolTable, value an Offset Into its String
+  * Heap.
+  *
+  * Dependant Class(es) or Structure(s) - N/A
+  *
+  * Ver : 1.1
+  *		- name is a Symbol Id (nameLength Removed).
+  * Ver : 1.0
+  *		- First Release.
+  */
+struct FlatAttribute {
+	uint32_t name;
+	uint32_t value;
+	uint32_t valueLength;
+};
+
+/** Class to Read One Node of a FlatDocument the Way a Node* Reads a Node
+  * (Tag, Value, Attributes, Children) : a Document and an Index, Cheap to
+  * Copy. Spans Point Into the Document and are Valid Until it is Changed
+  * or Destroyed. A Default Constructed Handle Refers to No Node.
+  *
+  * Dependant Class(es) or Structure(s) - FlatDocument, StringSpan
+  *
+  * Ver : 1.1
+  *		- Added TagId.
+  * Ver : 1.0
+  *		- First Release.
+  */
+class NodeHandle {
+	friend class FlatDocument;
+public:
+	NodeHandle();
+	NodeHandle(const FlatDocument * _doc, uint32_t _index);
+
+	bool IsValid() const;
+	uint32_t Index() const { return index; }
+	Utilities::StringSpan Tag() const;
+	uint32_t TagId() const;
+	Utilities::StringSpan Value() const;
+	size_t AttributeCount() const;
+	Utilities::StringSpan AttributeName(size_t i) const;
+	Utilities::StringSpan AttributeValue(size_t i) const;
+	NodeHandle Parent() const;
+	NodeHandle FirstChild() const;
+	NodeHandle NextSibling() const;
+	std::vector<NodeHandle> Children() const;
+	Node * ToNode(XMLDocument & xDoc) const;
+	void ShowInfo() const;
+
+	bool operator==(const NodeHandle & other) const { return doc == other.doc && index == other.index; }
+	bool operator!=(const NodeHandle & other) const { return !(*this == other); }
+private:
+	const FlatDocument * doc;
+	uint32_t index;
+};
+
+/** Class to Hold an XML Document as One Array of FlatNodes in Document
+  * Order (the Root is Node 0) With Their Text in One String Heap, so a
+  * Query Over the Whole Document is a Linear Sweep of Memory. Nodes are
+  * Added in Document Order Only : OpenNode Adds a Child to the Innermost
+  * Open Node, Then AddAttribute / SetValue Fill it in and CloseNode Ends
+  * it. Sizes are 32 Bit, so the Heap and the Arrays Hold Less Than 4G
+  * Entries (IsFull Tells When Something Did Not Fit). Tag and Attribute
+  * Names are Interned in a SymbolTable, Which is the Document's Own Unless
+  * One is Handed to the Constructor.
+  *
+  * Dependant Class(es) or Structure(s) - FlatNode, FlatAttribute,
+  *		NodeHandle, SymbolTable, XMLDocument
+  *
+  * Ver : 1.1
+  *		- Names Interned in a (Shareable) SymbolTable; Added
+  *		  getElementByTagId & getSymbols.
+  * Ver : 1.0
+  *		- First Release.
+  */
+class FlatDocument {
+	friend class NodeHandle;
+public:
+	static const uint32_t kNoNode = 0xFFFFFFFF;
+
+	FlatDocument(std::string _version = "1.0", std::string _encoding = "UTF-8");
+	FlatDocument(std::shared_ptr<SymbolTable> _symbols, std::string _version = "1.0", std::string _encoding = "UTF-8");
+	explicit FlatDocument(XMLDocument & xDoc, std::shared_ptr<SymbolTable> _symbols = nullptr);
+
+	// Methods associated with constructing XML
+	uint32_t OpenNode(const Utilities::StringSpan & _tag);
+	bool AddAttribute(const Utilities::StringSpan & _name, const Utilities::StringSpan & _value);
+	void SetValue(const Utilities::StringSpan & _value);
+	bool CloseNode();
+	NodeHandle getOpenNode() const;
+	void Clear();
+	void Reserve(size_t nodeCount, size_t heapBytes);
+	XMLDocument * ToXMLDocument() const;
+	bool IsFull() const { return full; }
+	size_t MemoryUsage() const;
+
+	// Methods associated with querying XML
+	std::vector<NodeHandle> getElementByTag(const std::string & _tagName) const;
+	std::vector<NodeHandle> getElementByTagId(uint32_t _tagId) const;
+	std::vector<NodeHandle> getElementByValue(const std::string & _value) const;
+	std::vector<NodeHandle> getDescendants(const NodeHandle & _node) const;
+	size_t getNodeCount() const { return records.size(); }
+
+	std::string getVersion() const;
+	void setVersion(const std::string & _version);
+	std::string getEncoding() const;
+	void setEncoding(const std::string & _encoding);
+	NodeHandle getRoot() const;
+	NodeHandle getNode(uint32_t index) const;
+	const std::shared_ptr<SymbolTable> & getSymbols() const { return symbols; }
+private:
+	std::shared_ptr<SymbolTable> symbols;
+	std::vector<FlatNode> records;
+	std::vector<FlatAttribute> attributeRecords;
+	std::string heap;
+	std::vector<uint32_t> openNodes;
+	std::vector<uint32_t> lastChildren;
+	std::string version;
+	std::string encoding;
+	bool full;
+
+	void Store(const char * data, size_t length, uint32_t & offset, uint32_t & stored);
+	uint32_t Intern(const Utilities::StringSpan & name);
+	uint32_t SubtreeEnd(uint32_t index) const;
+	void Flatten(XMLDocument & xDoc);
+	void Materialize(uint32_t index, Node * target, XMLDocument & xDoc) const;
 };
 #endif // !XML_DOCUMENT_H
\ No newline at end of file
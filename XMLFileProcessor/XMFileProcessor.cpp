@@ -1,7 +1,7 @@
 //////////////////////////////////////////////////////////////////////////
 // XMFileProcessor.cpp	:	Reads XML File Stream and Creates an XML	//
 //							Document.									//
-// Version				:	2.0											//
+// Version				:	3.14										//
 // -------------------------------------------------------------------- //
 // Copyright  Venkata Chekuri, 2016									//
 // All rights granted provided that this notice is retained.			//
@@ -18,21 +18,138 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <stack>
+#include <deque>
+#include <atomic>
 #include <cctype>
+#include <chrono>
 #include <string>
+#include <tuple>
+#include <thread>
 #include <vector>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <iostream>
+#include <algorithm>
 #include <unordered_map>
 
+/* Define XML_SCAN_SCALAR to Build Without the SSE2/AVX2 Scanning Kernels */
+#if !defined(XML_SCAN_SCALAR) && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+#define XML_SCAN_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#if defined(XML_SCAN_X86) && (defined(__GNUC__) || defined(__clang__))
+#define XML_TARGET_SSE2 __attribute__((target("sse2")))
+#define XML_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define XML_TARGET_SSE2
+#define XML_TARGET_AVX2
+#endif
+
+/* Define XML_WITH_ZLIB (Link zlib) and / or XML_WITH_ZSTD (Link libzstd) to
+ * Read gzip / zstd Compressed Files (Detected by Their Magic Bytes).
+ */
+#ifdef XML_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef XML_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+/* Define XML_TRACE to Record Parser Events (Toker::TraceEvents). Otherwise
+ * the Trace Points Below Compile to Nothing (Arguments are Not Evaluated).
+ */
+#ifdef XML_TRACE
+#define XML_TRACE_STATE(pContext, state) XMLScanner::TraceRing::RecordState((pContext), (state))
+#define XML_TRACE_TOKEN(pContext) XMLScanner::TraceRing::RecordToken(pContext)
+#define XML_TRACE_SCOPE(kind, depth) XMLScanner::TraceRing::RecordScope((kind), (depth))
+#else
+#define XML_TRACE_STATE(pContext, state) ((void)0)
+#define XML_TRACE_TOKEN(pContext) ((void)0)
+#define XML_TRACE_SCOPE(kind, depth) ((void)0)
+#endif
+
 #include "XMLFileProcessor.h"
 
 namespace XMLScanner {
+	/** Table of Character Scanning Kernels Used by the States. Each
+	  * Kernel Scans [pBegin, pEnd) and Returns a Pointer to the First
+	  * Matching Character (pEnd if There is None). The Table is Picked
+	  * Once at Runtime Depending on What the CPU Supports (AVX2, SSE2
+	  * or Plain Scalar Code), so One Binary Runs on Every x86 Host.
+	  *
+	  *		- FindTagDelim   : First '<' or '>'.
+	  *		- FindValueStop  : First '<', '>' or Whitespace Other Than ' '.
+	  *		- SkipWhitespace : First Character Which is Not Whitespace.
+	  *		- CountNewlines  : Number of '\n' Characters.
+	  *		- FindNonAscii   : First Byte Above 0x7F.
+	  *		- FindInvalidUtf8: First Byte Where the Text Stops Being Valid
+	  *		                   UTF-8 (Overlong Forms, Surrogates, Code Points
+	  *		                   Above U+10FFFF and a Character Cut Off by pEnd
+	  *		                   are Invalid).
+	  *
+	  * Whitespace Means the Same as std::isspace in the "C" Locale.
+	  *
+	  * Dependant Class(es) or Structure(s) - N/A
+	  *
+	  * Ver : 1.1
+	  *		- Added FindNonAscii & FindInvalidUtf8 (Input Encoding).
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	struct ScanKernels {
+		const char * name;
+		const char * (*FindTagDelim)(const char * pBegin, const char * pEnd);
+		const char * (*FindValueStop)(const char * pBegin, const char * pEnd);
+		const char * (*SkipWhitespace)(const char * pBegin, const char * pEnd);
+		size_t (*CountNewlines)(const char * pBegin, const char * pEnd);
+		const char * (*FindNonAscii)(const char * pBegin, const char * pEnd);
+		const char * (*FindInvalidUtf8)(const char * pBegin, const char * pEnd);
+
+		static const ScanKernels & Select();
+	};
+
+	/* Encodings the Input Can be In (See DetectEncoding). Anything But UTF-8 is
+	 * Transcoded to UTF-8 Before it is Scanned.
+	 */
+	enum InputEncoding { Undecided, Utf8, Latin1, Windows1252, Utf16LE, Utf16BE, Unsupported };
+
+	/** Structure Holding the Magic Quotes Protection Scheme : the Markers
+	  * (MagicQuotesR, Marker to Text) and the Index Used to Decode Them in
+	  * One Pass. The Table Never Changes, so Every Context (and Every
+	  * LazySource) Shares the One Built by Standard.
+	  *
+	  * Dependant Class(es) or Structure(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release (Moved Out of Context).
+	  */
+	struct MagicQuoteDecoder {
+		MagicQuoteDecoder();
+
+		std::unordered_map<std::string, std::string> MagicQuotesR;
+		void XMLProtectionMagicQuotes(std::string & str) const;
+		const char * FindMagicQuote(const char * pBegin, const char * pEnd) const;
+
+		/* MagicQuotesR Grouped by the Second Character of the Marker (See IndexMagicQuotes) */
+		std::vector<std::pair<std::string, std::string>> _magicQuotes[256];
+		bool _magicQuoteLead[256];
+		void IndexMagicQuotes();
+
+		static const MagicQuoteDecoder & Standard();
+	};
+
 	/** Structure to Store Context Information. The
 	  * Context Info Includes :
-	  *		- istream
-	  *		- XML Document
-	  *		- XML Scope Information
+	  *		- Input Character Range (Mapped File or Buffered Stream)
+	  *		- Current Token (Span Into the Input)
+	  *		- ParseHandler Receiving the Events
 	  *		- Current States & Available States
 	  *		- Magic Quotes Protection Scheme Information
 	  *
@@ -41,6 +158,49 @@ namespace XMLScanner {
 	  * 
 	  * Dependant Class(es) or Structure(s) - N/A
 	  * 
+	  * Ver : 3.8
+	  *		- Added _deferUtf8Check (Toker::ComputeParallel).
+	  * Ver : 3.7
+	  *		- Added _scanned, _scannedQuote, _pScanFrom & _pScanQuote (a Token
+	  *		  Fed in Pieces is Not Searched From its Start Again Every Time).
+	  * Ver : 3.6
+	  *		- Added _moreInput, _fedTags, _pColumnAnchor, _anchorColumn,
+	  *		  BeginValidation & ValidateEnd (Validating Fed Input).
+	  * Ver : 3.5
+	  *		- The Magic Quotes Table Moved to MagicQuoteDecoder (_pMagicQuotes).
+	  * Ver : 3.4
+	  *		- Added _inputEncoding, _transcoded, _utf8Buffer & _pendingInput
+	  *		  (Input Encoding) and _columnBase.
+	  * Ver : 3.3
+	  *		- Added Reset (Per Parse State, Used by Toker::Reset).
+	  * Ver : 3.2
+	  *		- Added _pProjection, _projectionAlive, _projectionDepth, _matchDepth,
+	  *		  Project & ProjectEnd (Toker::SetProjection).
+	  * Ver : 3.1
+	  *		- Added _pError, _openTags, _attributeSpans, _sawElement & Fail
+	  *		  (Toker::Validate).
+	  * Ver : 3.0
+	  *		- Added _stats, _timeStates, _depth & _maxDepth (Toker::GetStats).
+	  * Ver : 2.9
+	  *		- Added _lazyValues (Values Reported Undecoded, See Toker::SetLazyValues).
+	  * Ver : 2.8
+	  *		- MagicQuotesR Also Decodes the Standard Entities (&lt; &gt; &amp;
+	  *		  &quot; &apos;). Added _magicQuotes & _magicQuoteLead (Index Used
+	  *		  to Decode in One Pass).
+	  * Ver : 2.7
+	  *		- Added _scratchName & _scratchValue (Decoded Attributes, Reused).
+	  * Ver : 2.6
+	  *		- Added _resume (State to Run Next Between Toker::Feed Calls).
+	  * Ver : 2.4
+	  *		- Replaced xDoc and _scope With _pHandler (Moved to DocumentBuilder).
+	  *		  isCorrupt Moved to DocumentBuilder too.
+	  * Ver : 2.1
+	  *		- Replaced istream With a Character Range [_pBegin, _pEnd) Which
+	  *		  States Scan Directly. Input is Either a Mapped File or an
+	  *		  istream Read Into _inBuffer.
+	  *		- Token is Now a Span (tok) Into the Input. token is Only Used
+	  *		  When the Token Text Has to be Rewritten.
+	  *		- Added _pScan (Scanning Kernels Picked For This CPU).
 	  * Ver : 2.0
 	  *		- Updated Scope To be A Vector of Node Pointers From Vector
 	  *		  of Strings.
@@ -52,20 +212,58 @@ namespace XMLScanner {
 	struct Context {
 		Context();
 		~Context();
+		void Reset();
 
+		Utilities::StringSpan tok;
 		std::string token;
-		std::istream* _pIn;
+		std::string _scratchName;
+		std::string _scratchValue;
+
+		const char * _pBegin;
+		const char * _pCur;
+		const char * _pEnd;
+		bool _good;
+		const ScanKernels * _pScan;
+		Utilities::MappedFile _map;
+		std::string _inBuffer;
+
+		/* Input Encoding. Input Which is Not UTF-8 is Transcoded (Into _utf8Buffer,
+		 * or _inBuffer With Feed) and _transcoded Makes SetHeaders Report UTF-8.
+		 * With Feed, _pendingInput Holds the Bytes Not Decoded Yet (Before the
+		 * Encoding is Known, or a Character Cut Off by the End of a Piece).
+		 * While _deferUtf8Check is Set UTF-8 is Attached Without Being Validated
+		 * (Toker::ComputeParallel's Chunks Each Validate Their Own Range).
+		 */
+		InputEncoding _inputEncoding;
+		bool _transcoded;
+		bool _deferUtf8Check;
+		std::string _utf8Buffer;
+		std::string _pendingInput;
+
+		/* Characters of the Current Line Dropped From _inBuffer by Feed (For Fail) */
+		size_t _columnBase;
 
 		int prevChar;
 		int currChar;
 		size_t _lineCount;
 		
-		XMLDocument * xDoc;
+		ParseHandler * _pHandler;
+		unsigned _resume;
+		bool _lazyValues;
+
+		/* Dfa::Pump : How Far Past Where it Starts the State in _resume Has Already
+		 * Searched For the End of its Token (Without Finding it), and Where That is
+		 * in the Input While the State Runs (See State::ScanFrom). A Search Which Ran
+		 * Out Inside a Quoted Attribute Value Also Keeps Where the Value's Quote is
+		 * (npos / nullptr Otherwise, See State::FindQuotedTagDelim).
+		 */
+		size_t _scanned;
+		size_t _scannedQuote;
+		const char * _pScanFrom;
+		const char * _pScanQuote;
 
-		std::stack<Node *> _scope;
 		std::string _version;
 		std::string _encoding;
-		bool isCorrupt = false;
 
 		bool VERBOSE;
 
@@ -77,9 +275,99 @@ namespace XMLScanner {
 		State * _pEatHeaders;
 
 		bool MagicQuotes;
-		std::unordered_map<std::string, std::string> MagicQuotesR;
-		void XMLProtectionMagicQuotes(std::string & str);
+		const MagicQuoteDecoder * _pMagicQuotes;
+
+		/* Statistics of the Current Parse (Reset by State::Attach) */
+		ParseStats _stats;
+		bool _timeStates;
+		long _depth;
+		long _maxDepth;
+
+		void CountStartElement(const Utilities::StringSpan & tag) {
+			_stats.nodes++;
+			_stats.bytesAllocated += sizeof(Node) + sizeof(Node *) + tag.length;
+			if (++_depth > _maxDepth)
+				_maxDepth = _depth;
+		}
+		void CountAttribute(const Utilities::StringSpan & name, const Utilities::StringSpan & value) {
+			_stats.bytesAllocated += sizeof(std::pair<std::string, std::string>) + name.length + value.length;
+		}
+
+		/* Validation (Toker::Validate). States Only Check the Input While _pError is Set */
+		ParseError * _pError;
+		std::vector<Utilities::StringSpan> _openTags;
+		std::vector<std::pair<Utilities::StringSpan, Utilities::StringSpan>> _attributeSpans;
+		bool _sawElement;
+		void BeginValidation(ParseError * pError);
+		void ValidateEnd();
+		bool Fail(const char * pAt, const std::string & message);
+		bool Fail(size_t line, size_t column, const std::string & message);
+
+		/* While More Input May Follow (Dfa::Pump Without final) Markup Running to _pEnd
+		 * Waits For it Instead of Failing, and as Feed Drops the Input Already Read the
+		 * Open Tags are Copied to _fedTags (With Where They Start) For _openTags to
+		 * Point at. _pColumnAnchor (Column _anchorColumn) Saves Looking Back For the
+		 * Start of the Line Again.
+		 */
+		struct FedTag {
+			std::string name;
+			size_t line;
+			size_t column;
+		};
+		bool _moreInput;
+		std::deque<FedTag> _fedTags;
+		const char * _pColumnAnchor;
+		size_t _anchorColumn;
+
+		/* Projection (Toker::SetProjection). _projectionAlive[d] Holds the Patterns Still
+		 * Matching the d Open Ancestors (Level 0 is Every Pattern), _matchDepth the
+		 * Elements Open Inside a Matching Element.
+		 */
+		const std::vector<std::vector<std::string>> * _pProjection;
+		std::vector<std::vector<unsigned>> _projectionAlive;
+		size_t _projectionDepth;
+		size_t _matchDepth;
+		bool Project(const Utilities::StringSpan & tag);
+		void ProjectEnd() {
+			if (_matchDepth > 0)
+				_matchDepth--;
+			else if (_projectionDepth > 0)
+				_projectionDepth--;
+		}
+	};
+
+	/* Time Stamp For Toker::SetStateTiming (CPU Cycles on x86, Otherwise Nanoseconds) */
+	inline unsigned long long ReadCycles() {
+#ifdef XML_SCAN_X86
+		return __rdtsc();
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+#ifdef XML_TRACE
+	/** Process Wide Ring Buffer of TraceEvents (Only in XML_TRACE Builds).
+	  * Any Number of Threads (e.g. ComputeParallel Chunks) May Record at
+	  * Once Without Locking : Each Event Claims the Next Slot With One
+	  * Atomic Increment, and When the Ring is Full the Oldest Events are
+	  * Overwritten. Snapshot is Meant to be Called After a Parse.
+	  *
+	  * Dependant Class(es) or Structure(s) - TraceEvent, Context
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class TraceRing {
+	public:
+		static void RecordState(const Context * pContext, unsigned state);
+		static void RecordToken(const Context * pContext);
+		static void RecordScope(TraceEvent::Kind kind, size_t depth);
+		static std::vector<TraceEvent> Snapshot(size_t & overwritten);
+		static void Clear();
+	private:
+		static void Record(const TraceEvent & event);
 	};
+#endif
 
 	/** Template Class for Different State Classes. These derived States 
 	  * will help in processing the XML File (each state will have different
@@ -87,6 +375,9 @@ namespace XMLScanner {
 	  *
 	  * Dependant Class(es) or Structure(s) - Toker, Context
 	  * 
+	  * Ver : 2.1
+	  *		- States Scan the Context Character Range Instead of Reading One
+	  *		  Character at a Time (CollectChar Replaced by ConsumeTo/ConsumeAll).
 	  * Ver : 1.0
 	  *		- First Release.
 	  */
@@ -98,704 +389,5284 @@ namespace XMLScanner {
 		State(const State&) = delete;
 		State& operator=(const State&) = delete;
 		virtual ~State();
-		void Attach(std::istream * pIn);
+		void Attach(const char * pBegin, const char * pEnd);
 		virtual void EatChars() = 0;
 		void ConsumeChars() {
-			_pContext->_pState->EatChars();
+			State * pState = _pContext->_pState;
+			if (_pContext->_timeStates) {
+				unsigned long long start = ReadCycles();
+				pState->EatChars();
+				_pContext->_stats.cycles[pState->_id] += ReadCycles() - start;
+			}
+			else
+				pState->EatChars();
+			_pContext->_stats.tokens[pState->_id] += !_pContext->tok.empty();
+			XML_TRACE_TOKEN(_pContext);
 			_pContext->_pState = NextState();
 		}
 		std::vector<char> specialChars = { '<', '>' };
-		bool CanRead() { return _pContext->_pIn->good(); }
-		std::string GetTok() { return _pContext->token; }
-		bool HasTok() { return _pContext->token.size() > 0; }
+		bool CanRead() { return _pContext->_good; }
+		std::string GetTok() { return _pContext->tok.str(); }
+		bool HasTok() { return !_pContext->tok.empty(); }
 		State * NextState();
 		size_t CurrentLineCount() { return _pContext->_lineCount; }
 		void SetContext(Context * pContext);
 	protected:
 		Context * _pContext;
-		bool CollectChar();
+		unsigned char _id;
+		void ConsumeTo(const char * pLast);
+		void ConsumeAll();
+		const char * ScanFrom(const char * pBegin);
+		void SetToken(const char * pBegin, const char * pEnd, const std::vector<char> & excluded);
+		const char * FindTagClose(const char * pBegin, const std::vector<char> & excluded);
+		const char * FindQuotedTagDelim(const char * pBegin);
+		void NotClosed(const char * pOpen, const std::string & message);
+		void ClearToken();
+		Utilities::StringSpan Decode(const Utilities::StringSpan & text, std::string & scratch);
 		Token makeString(int ch);
+		void ValidateMarkup(const char * pOpen);
+		bool ValidateStartTag(const char * pOpen, const char * pClose);
+		bool ValidateAttributes(const char * p, const char * pEnd);
+		bool ValidateProcessingInstruction(const char * pOpen, const char * pClose);
+		bool ValidateEndTag(const char * pOpen, const char * pClose);
 	};
 }
 
 using namespace XMLScanner;
 using Token = std::string;
 
-/** Function to Modify String So That Protected XML Files
-  * i.e The One's Whose Tokens are Modified will be Reverted
-  * to Original Value(s). 
-  * More information related to this will be provided in "ReadMe.md"
-  * File.
+/*
+ * ----------------------------------------------------------------------
+ *  Parse Statistics
+ * ----------------------------------------------------------------------
+ */
+
+namespace {
+	/* Names of the States, Indexed by TraceEvent::State */
+	const char * kStateNames[ParseStats::kStates] = { "EatHeaders", "EatOpenTag", "EatCloseTag", "EatWhiteSpace", "EatValue" };
+}
+
+/** Constructor For ParseStats Structure. Every Counter Starts at 0.
   *
   * Dependant Function(s) - N/A
-  * 
+  *
   * Ver : 1.0
   *		- First Release.
   */
-void Context::XMLProtectionMagicQuotes(std::string & str) {
-	for (std::pair<std::string, std::string> pr : MagicQuotesR) {
-		size_t start_pos = 0;
-		while (str.find(pr.first, start_pos) != std::string::npos) {
-			start_pos = str.find(pr.first, start_pos);
-			str.replace(start_pos, pr.first.length(), pr.second);
-			start_pos += pr.second.length();
-		}
+ParseStats::ParseStats() {
+	bytes = nodes = maxDepth = bytesAllocated = 0;
+	timed = false;
+	for (unsigned i = 0; i < kStates; i++) {
+		tokens[i] = 0;
+		cycles[i] = 0;
 	}
 }
 
-/** Function to Set the Current Context.
-  * 
+/** Function to Export the Statistics as a JSON Object. Per State Counters
+  * are Objects Keyed by the State Name; cycles is null Unless timed.
+  *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-void State::SetContext(Context * pContext) {
-	_pContext = pContext;
+std::string ParseStats::ToJson() const {
+	std::string json = "{\"bytes\":" + std::to_string(bytes) + ",\"tokens\":{";
+	for (unsigned i = 0; i < kStates; i++)
+		json += (i ? ",\"" : "\"") + std::string(kStateNames[i]) + "\":" + std::to_string(tokens[i]);
+	json += "},\"nodes\":" + std::to_string(nodes) + ",\"maxDepth\":" + std::to_string(maxDepth) +
+		",\"bytesAllocated\":" + std::to_string(bytesAllocated) + ",\"cycles\":";
+	if (!timed)
+		return json + "null}";
+	json += "{";
+	for (unsigned i = 0; i < kStates; i++)
+		json += (i ? ",\"" : "\"") + std::string(kStateNames[i]) + "\":" + std::to_string(cycles[i]);
+	return json + "}}";
+}
+
+/*
+ * ----------------------------------------------------------------------
+ *  Tracing (XML_TRACE Builds Only)
+ * ----------------------------------------------------------------------
+ */
+
+#ifdef XML_TRACE
+namespace {
+	/* Number of Events Kept (Power of 2) */
+	const size_t kTraceSlots = 1 << 16;
+
+	/* seq is 0 While the Slot is Being Written, Otherwise 1 + the Number of
+	 * the Event it Holds.
+	 */
+	struct TraceSlot {
+		std::atomic<size_t> seq;
+		TraceEvent event;
+	};
+
+	TraceSlot gTraceSlots[kTraceSlots];
+	std::atomic<size_t> gTraceHead(0);
 }
 
-/** Function to Attach File Stream to the State.
+/** Function to Store an Event in the Next Slot.
   *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-void State::Attach(std::istream * pIn) {
-	_pContext->_pState = _pContext->_pEatHeaders;
-	_pContext->_pIn = pIn;
+void TraceRing::Record(const TraceEvent & event) {
+	size_t number = gTraceHead.fetch_add(1, std::memory_order_relaxed);
+	TraceSlot & slot = gTraceSlots[number & (kTraceSlots - 1)];
+	slot.seq.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.event = event;
+	slot.seq.store(number + 1, std::memory_order_release);
 }
 
-/** Function to Read Next Character From File Stream.
-  * We are Also Updating prevChar & lineCount.
+/** Function to Record That the Parser Enters state at the Cursor.
   *
-  * Dependant Function(s) - N/A
+  * Dependant Function(s) - TraceRing::Record
   *
   * Ver : 1.0
   *		- First Release.
   */
-bool State::CollectChar() {
-	if (_pContext->_pIn->good())
-	{
-		_pContext->prevChar = _pContext->currChar;
-		_pContext->currChar = _pContext->_pIn->get();
-		if (_pContext->currChar == '\n')
-			++(_pContext->_lineCount);
-		return true;
-	}
-	return false;
+void TraceRing::RecordState(const Context * pContext, unsigned state) {
+	TraceEvent event;
+	event.kind = TraceEvent::StateChange;
+	event.state = (unsigned char)state;
+	event.offset = pContext->_pCur - pContext->_pBegin;
+	event.size = 0;
+	event.line = pContext->_lineCount;
+	Record(event);
 }
 
-/** Function to Convert Character into String.
+/** Function to Record the Token a State Has Just Read (Nothing if it Did
+  * Not Read One).
+  *
+  * Dependant Function(s) - TraceRing::Record
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void TraceRing::RecordToken(const Context * pContext) {
+	if (pContext->tok.empty())
+		return;
+	TraceEvent event;
+	event.kind = TraceEvent::Token;
+	event.state = 0;
+	event.offset = pContext->_pCur - pContext->_pBegin;
+	event.size = pContext->tok.length;
+	event.line = pContext->_lineCount;
+	Record(event);
+}
+
+/** Function to Record a Scope Push / Pop and the Resulting Depth.
+  *
+  * Dependant Function(s) - TraceRing::Record
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void TraceRing::RecordScope(TraceEvent::Kind kind, size_t depth) {
+	TraceEvent event;
+	event.kind = kind;
+	event.state = 0;
+	event.offset = 0;
+	event.size = depth;
+	event.line = 0;
+	Record(event);
+}
+
+/** Function to Copy the Recorded Events, Oldest First. overwritten is Set
+  * to the Number of Older Events Which No Longer Fit in the Ring. Slots
+  * Which are Being Written During the Call are Skipped.
   *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-State::Token State::makeString(int ch)
-{
-	Token temp;
-	return temp += ch;
+std::vector<TraceEvent> TraceRing::Snapshot(size_t & overwritten) {
+	size_t head = gTraceHead.load(std::memory_order_acquire);
+	size_t first = head > kTraceSlots ? head - kTraceSlots : 0;
+	overwritten = first;
+	std::vector<TraceEvent> events;
+	events.reserve(head - first);
+	for (size_t number = first; number < head; number++) {
+		TraceSlot & slot = gTraceSlots[number & (kTraceSlots - 1)];
+		if (slot.seq.load(std::memory_order_acquire) != number + 1)
+			continue;
+		TraceEvent event = slot.event;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.seq.load(std::memory_order_relaxed) == number + 1)
+			events.push_back(event);
+	}
+	return events;
 }
 
-/** Function to Transition Into Next State. Here
-  * we Analyze the Current and/or Previous and/or
-  * Next Character to Select the Next State. 
+/** Function to Drop Every Recorded Event.
   *
   * Dependant Function(s) - N/A
   *
-  * Ver : 2.0
-  *		- Added VERBOSE Mode Support.
   * Ver : 1.0
   *		- First Release.
   */
-State* State::NextState()
-{
-	if (!(_pContext->_pIn->good()))
-	{
-		return nullptr;
+void TraceRing::Clear() {
+	for (TraceSlot & slot : gTraceSlots)
+		slot.seq.store(0, std::memory_order_relaxed);
+	gTraceHead.store(0, std::memory_order_release);
+}
+#endif
+
+/*
+ * ----------------------------------------------------------------------
+ *  Scanning Kernels
+ * ----------------------------------------------------------------------
+ */
+
+namespace {
+	/* Whitespace as Defined by std::isspace in the "C" Locale */
+	inline bool IsSpace(unsigned char ch) {
+		return ch == ' ' || (unsigned char)(ch - '\t') < 5;
 	}
-	int chNext = _pContext->_pIn->peek();
-	if (chNext == EOF)
-	{
-		_pContext->_pIn->clear();
-		/* if peek() reads end of file character, EOF, then eofbit is set and
-		 * _pIn->good() will return false.  clear() restores state to good
-		 */
+
+	/* Characters Which May Start / Continue an XML Name (Bytes >= 0x80 are Taken as Part of a UTF-8 Name) */
+	inline bool IsNameStart(unsigned char ch) {
+		return (unsigned)((ch | 0x20) - 'a') < 26 || ch == '_' || ch == ':' || ch >= 0x80;
 	}
-	
-	/* The following tests must come first */
-	if (_pContext->currChar == '<' && chNext == '?')
-	{
-		if(_pContext->VERBOSE)
-			std::cout << "\n [VERBOSE] : STATE = EatHeaders";
-		return _pContext->_pEatHeaders;
+
+	inline bool IsNameChar(unsigned char ch) {
+		return IsNameStart(ch) || (unsigned)(ch - '0') < 10 || ch == '-' || ch == '.';
 	}
-	if (_pContext->currChar == '<' && chNext != '/')
-	{
-		if (_pContext->VERBOSE)
-			std::cout << "\n [VERBOSE] : STATE = EatOpenTag";
-		return _pContext->_pEatOpenTag;
+
+	inline bool SameText(const Utilities::StringSpan & a, const Utilities::StringSpan & b) {
+		return a.length == b.length && std::memcmp(a.data, b.data, a.length) == 0;
 	}
-	if (_pContext->currChar == '<' && chNext == '/')
-	{
-		if (_pContext->VERBOSE)
-			std::cout << "\n [VERBOSE] : STATE = EatCloseTag";
-		return _pContext->_pEatCloseTag;
+
+	/* First Occurrence of the Literal in [p, pEnd), or nullptr */
+	const char * FindText(const char * p, const char * pEnd, const char * literal) {
+		size_t length = std::strlen(literal);
+		const char * pFound = std::search(p, pEnd, literal, literal + length);
+		return pFound == pEnd ? nullptr : pFound;
 	}
-	if (std::isspace(_pContext->currChar))
-	{
-		if (_pContext->VERBOSE)
-			std::cout << "\n [VERBOSE] : STATE = EatWhiteSpace";
-		return _pContext->_pEatWhitespace;
+
+	const char * ScalarFindTagDelim(const char * p, const char * pEnd) {
+		while (p != pEnd && *p != '<' && *p != '>')
+			++p;
+		return p;
 	}
-	if (!std::isspace(_pContext->currChar) && _pContext->currChar != '>')
-	{
-		if (_pContext->VERBOSE)
-			std::cout << "\n [VERBOSE] : STATE = EatValue";
-		return _pContext->_pEatValue;
+
+	const char * ScalarFindValueStop(const char * p, const char * pEnd) {
+		while (p != pEnd && *p != '<' && *p != '>' && (*p == ' ' || !IsSpace((unsigned char)*p)))
+			++p;
+		return p;
 	}
-	if (!_pContext->_pIn->good())
-	{
-		if (_pContext->VERBOSE)
-			std::cout << "\n [VERBOSE] : STATE = No Match (Default to EatWhiteSpace)";
-		return _pContext->_pEatWhitespace;
+
+	const char * ScalarSkipWhitespace(const char * p, const char * pEnd) {
+		while (p != pEnd && IsSpace((unsigned char)*p))
+			++p;
+		return p;
 	}
-	
-	/* If _pContext->currChar is not a state transition char
-	 * then send it to Eat Value State.
+
+	size_t ScalarCountNewlines(const char * p, const char * pEnd) {
+		size_t count = 0;
+		for (; p != pEnd; ++p)
+			count += (*p == '\n');
+		return count;
+	}
+
+	const char * ScalarFindNonAscii(const char * p, const char * pEnd) {
+		while (p != pEnd && (unsigned char)*p < 0x80)
+			++p;
+		return p;
+	}
+
+	/* Length of the Valid UTF-8 Character at p (p < pEnd, *p Above 0x7F), or 0 */
+	size_t Utf8CharLength(const char * p, const char * pEnd) {
+		const unsigned char * u = (const unsigned char *)p;
+		size_t length;
+		unsigned char low = 0x80, high = 0xBF;	/* Range of the Second Byte */
+		if (u[0] >= 0xC2 && u[0] <= 0xDF)
+			length = 2;
+		else if (u[0] >= 0xE0 && u[0] <= 0xEF) {
+			length = 3;
+			if (u[0] == 0xE0)
+				low = 0xA0;
+			else if (u[0] == 0xED)
+				high = 0x9F;
+		}
+		else if (u[0] >= 0xF0 && u[0] <= 0xF4) {
+			length = 4;
+			if (u[0] == 0xF0)
+				low = 0x90;
+			else if (u[0] == 0xF4)
+				high = 0x8F;
+		}
+		else
+			return 0;
+		if ((size_t)(pEnd - p) < length || u[1] < low || u[1] > high)
+			return 0;
+		for (size_t i = 2; i < length; ++i)
+			if ((u[i] & 0xC0) != 0x80)
+				return 0;
+		return length;
+	}
+
+	const char * ScalarFindInvalidUtf8(const char * p, const char * pEnd) {
+		while (p != pEnd) {
+			if ((unsigned char)*p < 0x80) {
+				++p;
+				continue;
+			}
+			size_t length = Utf8CharLength(p, pEnd);
+			if (length == 0)
+				return p;
+			p += length;
+		}
+		return p;
+	}
+
+#ifdef XML_SCAN_X86
+	inline unsigned FirstSetBit(unsigned mask) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return (unsigned)index;
+#else
+		return (unsigned)__builtin_ctz(mask);
+#endif
+	}
+
+	/* SSE2 Kernels (16 Bytes per Step) */
+
+	XML_TARGET_SSE2 const char * Sse2FindTagDelim(const char * p, const char * pEnd) {
+		const __m128i lt = _mm_set1_epi8('<');
+		const __m128i gt = _mm_set1_epi8('>');
+		for (; pEnd - p >= 16; p += 16) {
+			__m128i v = _mm_loadu_si128((const __m128i *)p);
+			__m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, lt), _mm_cmpeq_epi8(v, gt));
+			unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+			if (mask != 0)
+				return p + FirstSetBit(mask);
+		}
+		return ScalarFindTagDelim(p, pEnd);
+	}
+
+	XML_TARGET_SSE2 const char * Sse2FindValueStop(const char * p, const char * pEnd) {
+		const __m128i lt = _mm_set1_epi8('<');
+		const __m128i gt = _mm_set1_epi8('>');
+		const __m128i tab = _mm_set1_epi8('\t');
+		const __m128i four = _mm_set1_epi8(4);
+		for (; pEnd - p >= 16; p += 16) {
+			__m128i v = _mm_loadu_si128((const __m128i *)p);
+			/* '\t' .. '\r' is the Unsigned Range [0, 4] After Subtracting '\t' */
+			__m128i rel = _mm_sub_epi8(v, tab);
+			__m128i ws = _mm_cmpeq_epi8(_mm_min_epu8(rel, four), rel);
+			__m128i hit = _mm_or_si128(ws, _mm_or_si128(_mm_cmpeq_epi8(v, lt), _mm_cmpeq_epi8(v, gt)));
+			unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+			if (mask != 0)
+				return p + FirstSetBit(mask);
+		}
+		return ScalarFindValueStop(p, pEnd);
+	}
+
+	XML_TARGET_SSE2 const char * Sse2SkipWhitespace(const char * p, const char * pEnd) {
+		const __m128i sp = _mm_set1_epi8(' ');
+		const __m128i tab = _mm_set1_epi8('\t');
+		const __m128i four = _mm_set1_epi8(4);
+		for (; pEnd - p >= 16; p += 16) {
+			__m128i v = _mm_loadu_si128((const __m128i *)p);
+			__m128i rel = _mm_sub_epi8(v, tab);
+			__m128i ws = _mm_or_si128(_mm_cmpeq_epi8(v, sp), _mm_cmpeq_epi8(_mm_min_epu8(rel, four), rel));
+			unsigned mask = ~(unsigned)_mm_movemask_epi8(ws) & 0xFFFFu;
+			if (mask != 0)
+				return p + FirstSetBit(mask);
+		}
+		return ScalarSkipWhitespace(p, pEnd);
+	}
+
+	XML_TARGET_SSE2 size_t Sse2CountNewlines(const char * p, const char * pEnd) {
+		const __m128i nl = _mm_set1_epi8('\n');
+		size_t count = 0;
+		while (pEnd - p >= 16) {
+			/* Byte Counters Overflow After 255 Steps */
+			__m128i acc = _mm_setzero_si128();
+			for (int i = 0; i < 255 && pEnd - p >= 16; ++i, p += 16)
+				acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)p), nl));
+			__m128i sum = _mm_sad_epu8(acc, _mm_setzero_si128());
+			count += (size_t)_mm_cvtsi128_si32(sum) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+		}
+		return count + ScalarCountNewlines(p, pEnd);
+	}
+
+	XML_TARGET_SSE2 const char * Sse2FindNonAscii(const char * p, const char * pEnd) {
+		for (; pEnd - p >= 16; p += 16) {
+			unsigned mask = (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)p));
+			if (mask != 0)
+				return p + FirstSetBit(mask);
+		}
+		return ScalarFindNonAscii(p, pEnd);
+	}
+
+	/* ASCII Runs are Skipped 16 Bytes at a Time, Other Characters Checked One by One */
+	XML_TARGET_SSE2 const char * Sse2FindInvalidUtf8(const char * p, const char * pEnd) {
+		while ((p = Sse2FindNonAscii(p, pEnd)) != pEnd) {
+			size_t length = Utf8CharLength(p, pEnd);
+			if (length == 0)
+				return p;
+			p += length;
+		}
+		return p;
+	}
+
+	/* AVX2 Kernels (32 Bytes per Step). The Upper Halves of the Registers are
+	 * Cleared (vzeroupper) Before Handing the Tail to the SSE2 Kernels, Else
+	 * Every Legacy SSE Instruction After Them Pays a Transition Penalty.
 	 */
-	return _pContext->_pEatWhitespace;
+
+	XML_TARGET_AVX2 const char * Avx2FindTagDelim(const char * p, const char * pEnd) {
+		const __m256i lt = _mm256_set1_epi8('<');
+		const __m256i gt = _mm256_set1_epi8('>');
+		for (; pEnd - p >= 32; p += 32) {
+			__m256i v = _mm256_loadu_si256((const __m256i *)p);
+			__m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, lt), _mm256_cmpeq_epi8(v, gt));
+			unsigned mask = (unsigned)_mm256_movemask_epi8(hit);
+			if (mask != 0)
+				return p + FirstSetBit(mask);
+		}
+		_mm256_zeroupper();
+		return Sse2FindTagDelim(p, pEnd);
+	}
+
+	XML_TARGET_AVX2 const char * Avx2FindValueStop(const char * p, const char * pEnd) {
+		const __m256i lt = _mm256_set1_epi8('<');
+		const __m256i gt = _mm256_set1_epi8('>');
+		const __m256i tab = _mm256_set1_epi8('\t');
+		const __m256i four = _mm256_set1_epi8(4);
+		for (; pEnd - p >= 32; p += 32) {
+			__m256i v = _mm256_loadu_si256((const __m256i *)p);
+			__m256i rel = _mm256_sub_epi8(v, tab);
+			__m256i ws = _mm256_cmpeq_epi8(_mm256_min_epu8(rel, four), rel);
+			__m256i hit = _mm256_or_si256(ws, _mm256_or_si256(_mm256_cmpeq_epi8(v, lt), _mm256_cmpeq_epi8(v, gt)));
+			unsigned mask = (unsigned)_mm256_movemask_epi8(hit);
+			if (mask != 0)
+				return p + FirstSetBit(mask);
+		}
+		_mm256_zeroupper();
+		return Sse2FindValueStop(p, pEnd);
+	}
+
+	XML_TARGET_AVX2 const char * Avx2SkipWhitespace(const char * p, const char * pEnd) {
+		const __m256i sp = _mm256_set1_epi8(' ');
+		const __m256i tab = _mm256_set1_epi8('\t');
+		const __m256i four = _mm256_set1_epi8(4);
+		for (; pEnd - p >= 32; p += 32) {
+			__m256i v = _mm256_loadu_si256((const __m256i *)p);
+			__m256i rel = _mm256_sub_epi8(v, tab);
+			__m256i ws = _mm256_or_si256(_mm256_cmpeq_epi8(v, sp), _mm256_cmpeq_epi8(_mm256_min_epu8(rel, four), rel));
+			unsigned mask = ~(unsigned)_mm256_movemask_epi8(ws);
+			if (mask != 0)
+				return p + FirstSetBit(mask);
+		}
+		_mm256_zeroupper();
+		return Sse2SkipWhitespace(p, pEnd);
+	}
+
+	XML_TARGET_AVX2 size_t Avx2CountNewlines(const char * p, const char * pEnd) {
+		const __m256i nl = _mm256_set1_epi8('\n');
+		size_t count = 0;
+		while (pEnd - p >= 32) {
+			__m256i acc = _mm256_setzero_si256();
+			for (int i = 0; i < 255 && pEnd - p >= 32; ++i, p += 32)
+				acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)p), nl));
+			__m256i sum = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+			__m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+			count += (size_t)_mm_cvtsi128_si32(half) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(half, 8));
+		}
+		_mm256_zeroupper();
+		return count + Sse2CountNewlines(p, pEnd);
+	}
+
+	XML_TARGET_AVX2 const char * Avx2FindNonAscii(const char * p, const char * pEnd) {
+		for (; pEnd - p >= 32; p += 32) {
+			unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *)p));
+			if (mask != 0)
+				return p + FirstSetBit(mask);
+		}
+		_mm256_zeroupper();
+		return Sse2FindNonAscii(p, pEnd);
+	}
+
+	/* Bytes [15 - n, 32 - n) of prev:input, i.e. input Moved Up n Bytes With the
+	 * Last n Bytes of the Previous Block in Front
+	 */
+	template <int n>
+	XML_TARGET_AVX2 inline __m256i Avx2Prev(__m256i input, __m256i prev) {
+		return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - n);
+	}
+
+	/* UTF-8 Validation 32 Bytes at a Time Without Branches (Keiser & Lemire,
+	 * "Validating UTF-8 In Less Than One Instruction Per Byte"). Three Nibble
+	 * Lookups Classify Every Pair of Adjacent Bytes; the Error Bits Which
+	 * Survive the AND Mark Too Short / Too Long Sequences, Overlong Forms,
+	 * Surrogates and Code Points Above U+10FFFF. Whether the Third and Fourth
+	 * Bytes of a Character are Continuations is Checked Separately. Blocks of
+	 * ASCII Only Check That the Previous Block Did Not End Inside a Character.
+	 * Once a Block Has an Error (and For the Tail) the Scalar Kernel Takes
+	 * Over From the Character Boundary Before it, to Say Exactly Where.
+	 */
+	XML_TARGET_AVX2 const char * Avx2FindInvalidUtf8(const char * p, const char * pEnd) {
+		const char * pStart = p;
+		const __m256i byte1High = _mm256_setr_epi8(
+			0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, (char)0x80, (char)0x80, (char)0x80, (char)0x80, 0x21, 0x01, 0x15, 0x49,
+			0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, (char)0x80, (char)0x80, (char)0x80, (char)0x80, 0x21, 0x01, 0x15, 0x49);
+		const __m256i byte1Low = _mm256_setr_epi8(
+			(char)0xE7, (char)0xA3, (char)0x83, (char)0x83, (char)0x8B, (char)0xCB, (char)0xCB, (char)0xCB,
+			(char)0xCB, (char)0xCB, (char)0xCB, (char)0xCB, (char)0xCB, (char)0xDB, (char)0xCB, (char)0xCB,
+			(char)0xE7, (char)0xA3, (char)0x83, (char)0x83, (char)0x8B, (char)0xCB, (char)0xCB, (char)0xCB,
+			(char)0xCB, (char)0xCB, (char)0xCB, (char)0xCB, (char)0xCB, (char)0xDB, (char)0xCB, (char)0xCB);
+		const __m256i byte2High = _mm256_setr_epi8(
+			0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, (char)0xE6, (char)0xAE, (char)0xBA, (char)0xBA, 0x01, 0x01, 0x01, 0x01,
+			0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, (char)0xE6, (char)0xAE, (char)0xBA, (char)0xBA, 0x01, 0x01, 0x01, 0x01);
+		/* Bytes Which Start a Character Too Long to End in the Block */
+		const __m256i incompleteMax = _mm256_setr_epi8(
+			-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+		const __m256i nibble = _mm256_set1_epi8(0x0F);
+		const __m256i third = _mm256_set1_epi8(0xE0 - 0x80);
+		const __m256i fourth = _mm256_set1_epi8(0xF0 - 0x80);
+		const __m256i top = _mm256_set1_epi8((char)0x80);
+		__m256i prev = _mm256_setzero_si256();
+		__m256i incomplete = _mm256_setzero_si256();
+		__m256i error = _mm256_setzero_si256();
+		for (; pEnd - p >= 32; p += 32) {
+			__m256i input = _mm256_loadu_si256((const __m256i *)p);
+			if (_mm256_movemask_epi8(input) == 0)
+				error = _mm256_or_si256(error, incomplete);
+			else {
+				__m256i prev1 = Avx2Prev<1>(input, prev);
+				__m256i special = _mm256_and_si256(_mm256_and_si256(
+					_mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+					_mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, nibble))),
+					_mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+				__m256i must23 = _mm256_or_si256(_mm256_subs_epu8(Avx2Prev<2>(input, prev), third),
+					_mm256_subs_epu8(Avx2Prev<3>(input, prev), fourth));
+				error = _mm256_or_si256(error, _mm256_xor_si256(_mm256_and_si256(must23, top), special));
+				incomplete = _mm256_subs_epu8(input, incompleteMax);
+			}
+			if (!_mm256_testz_si256(error, error))
+				break;
+			prev = input;
+		}
+		_mm256_zeroupper();
+		/* Everything Before p - 3 is Valid; Back Up to the Start of a Character */
+		const char * q = p - std::min<size_t>(p - pStart, 3);
+		while (q != pStart && ((unsigned char)*q & 0xC0) == 0x80)
+			--q;
+		return ScalarFindInvalidUtf8(q, pEnd);
+	}
+
+	/* CPU Feature Detection */
+	void DetectCpu(bool & sse2, bool & avx2) {
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+		__cpuid(info, 1);
+		sse2 = (info[3] & (1 << 26)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		avx2 = false;
+		if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6) {
+			__cpuidex(info, 7, 0);
+			avx2 = (info[1] & (1 << 5)) != 0;
+		}
+#else
+		__builtin_cpu_init();
+		sse2 = __builtin_cpu_supports("sse2") != 0;
+		avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+	}
+#endif // XML_SCAN_X86
+
+	ScanKernels PickKernels() {
+		ScanKernels scalar = { "Scalar", ScalarFindTagDelim, ScalarFindValueStop, ScalarSkipWhitespace, ScalarCountNewlines,
+			ScalarFindNonAscii, ScalarFindInvalidUtf8 };
+#ifdef XML_SCAN_X86
+		bool sse2 = false, avx2 = false;
+		DetectCpu(sse2, avx2);
+		if (avx2) {
+			ScanKernels kernels = { "AVX2", Avx2FindTagDelim, Avx2FindValueStop, Avx2SkipWhitespace, Avx2CountNewlines,
+				Avx2FindNonAscii, Avx2FindInvalidUtf8 };
+			return kernels;
+		}
+		if (sse2) {
+			ScanKernels kernels = { "SSE2", Sse2FindTagDelim, Sse2FindValueStop, Sse2SkipWhitespace, Sse2CountNewlines,
+				Sse2FindNonAscii, Sse2FindInvalidUtf8 };
+			return kernels;
+		}
+#endif
+		return scalar;
+	}
 }
 
-/** State Which will Perform the Functions when the File Stream
-  * Characters are Whitespace(s).
+/** Function to Get the Scanning Kernels For This CPU. The CPU is Only
+  * Checked on the First Call.
   *
-  * Dependant Class(es) or Structure(s) - State, Context
+  * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-class EatWhitespace : public State {
-public:
-	EatWhitespace(Context * pContext) { _pContext = pContext; }
-	
-	/** Function to Act Immediately After Transitioning into this
-	  * State.
-	  * This Function Will Simply Keep on Reading Next Character
-	  * Until a Non-Whitespace Character is Encountered.
+const ScanKernels & ScanKernels::Select() {
+	static const ScanKernels kernels = PickKernels();
+	return kernels;
+}
+
+namespace {
+	/** Function to Append a Code Point (At Most U+10FFFF) to out in UTF-8.
 	  *
-	  * Dependant Function(s) - State::CollectChar
-	  * 
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release (Moved Out of DecodeCharRef).
+	  */
+	void AppendUtf8(unsigned long code, std::string & out) {
+		if (code < 0x80) {
+			out.push_back((char)code);
+		}
+		else if (code < 0x800) {
+			out.push_back((char)(0xC0 | (code >> 6)));
+			out.push_back((char)(0x80 | (code & 0x3F)));
+		}
+		else if (code < 0x10000) {
+			out.push_back((char)(0xE0 | (code >> 12)));
+			out.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+			out.push_back((char)(0x80 | (code & 0x3F)));
+		}
+		else {
+			out.push_back((char)(0xF0 | (code >> 18)));
+			out.push_back((char)(0x80 | ((code >> 12) & 0x3F)));
+			out.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+			out.push_back((char)(0x80 | (code & 0x3F)));
+		}
+	}
+
+	/** Function to Decode a Numeric Character Reference (&#65; or &#x41;)
+	  * Starting at p Into out (UTF-8). Returns the Length of the Reference,
+	  * or 0 if p Does Not Start a Valid One (Including References to 0,
+	  * Surrogates and Code Points Above 0x10FFFF, Which Have No UTF-8 Form).
+	  *
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.1
+	  *		- Rejects Surrogate Code Points.
 	  * Ver : 1.0
 	  *		- First Release.
 	  */
-	virtual void EatChars() {
-		_pContext->token.clear();
-		do {
-			if (!CollectChar())
-				return;
-		} while (std::isspace(_pContext->currChar));
+	size_t DecodeCharRef(const char * p, const char * pEnd, std::string & out) {
+		const char * q = p + 2;
+		bool hex = q != pEnd && (*q == 'x' || *q == 'X');
+		if (hex)
+			++q;
+		unsigned long code = 0;
+		const char * pDigits = q;
+		for (; q != pEnd && q - pDigits < 8; ++q) {
+			int digit;
+			if (*q >= '0' && *q <= '9')
+				digit = *q - '0';
+			else if (hex && *q >= 'a' && *q <= 'f')
+				digit = *q - 'a' + 10;
+			else if (hex && *q >= 'A' && *q <= 'F')
+				digit = *q - 'A' + 10;
+			else
+				break;
+			code = code * (hex ? 16 : 10) + digit;
+		}
+		if (q == pDigits || q == pEnd || *q != ';' || code == 0 || code > 0x10FFFF ||
+			(code >= 0xD800 && code <= 0xDFFF))
+			return 0;
+		out.clear();
+		AppendUtf8(code, out);
+		return q + 1 - p;
 	}
-};
+}
 
-/** State Which will Perform the Functions when the File Stream
-  * Begins with XML Open Tag.
+/** Function to Build the Index Used by XMLProtectionMagicQuotes. Markers
+  * are Grouped by Their Second Character and the First Characters are
+  * Flagged in _magicQuoteLead, so a Marker is Looked For Only Where a Lead
+  * Character is and Only Among the Few Markers of That Group. '&' is Always
+  * a Lead Character (Numeric Character References).
   *
-  * Dependant Class(es) or Structure(s) - State, Context
+  * Dependant Function(s) - N/A
   *
-  * Ver : 2.0
-  *		- Removed TagHelper Function. No Longer Needed.
+  * Ver : 1.1
+  *		- Moved to MagicQuoteDecoder.
   * Ver : 1.0
   *		- First Release.
   */
-class EatOpenTag : public State {
-public:
-	EatOpenTag(Context * pContext) { _pContext = pContext; }
-	
-	/** Function to Act Immediately After Transitioning into this
-	* State.
-	* This Function Will Simply Keep on Reading Next Character
-	* Until one of the specialChars Character is Encountered.
-	*
-	* Dependant Function(s) - State::CollectChar, EatOpenTag::SetNodeInfo
-	*
-	* Ver : 2.0
-	*		- Not Using Nodes Anymore.
-	*		- Scope Variable Changed. Now it Takes Node Pointer.
-	*/
-	virtual void EatChars() {
-		_pContext->token.clear();
-		do {
-			if (!CollectChar())
-				return;
-			if(std::find(specialChars.begin(), specialChars.end(), _pContext->currChar) == specialChars.end())
-				_pContext->token.push_back(_pContext->currChar);
-		} while (_pContext->currChar != '>');
-
-		if (!_pContext->token.empty()) {
-			Node * newNode = new Node();
-			SetNodeInfo(newNode);
-			if (_pContext->_scope.empty())
-				_pContext->xDoc->AddChild(newNode);
-			else
-				_pContext->xDoc->AddChild(newNode, _pContext->_scope.top());
-			_pContext->_scope.push(newNode);
-			if (_pContext->VERBOSE)
-				std::cout << "\n [VERBOSE] : Pushed New Element \"" << _pContext->_scope.top()->tag << "\" onto Scope Stack";
-		}
+void MagicQuoteDecoder::IndexMagicQuotes() {
+	for (size_t i = 0; i < 256; i++) {
+		_magicQuotes[i].clear();
+		_magicQuoteLead[i] = false;
 	}
-private:
-	/** Funtion to Set the Node Information to Node Pointer. This Method will
-	  * Process Open Tag State Token to Get Tag Name and it's Associated Attributes
-	  * and Adds them to "node" Variable.
-	  *
-	  * Dependant Function(s) - StringHelper::Split, Context::XMLProtectionMagicQuotes
-	  *
-	  * Ver : 2.0
-	  *		- Added VERBOSE Mode Feature.
-	  * Ver : 1.0
-	  *		- First Release.
-	  */
-	void SetNodeInfo(Node * node) {
-		std::vector<std::string> tokSplit = Utilities::StringHelper::Split(_pContext->token, ' ');
-		/* MagicQuotes Protection */
-		if (_pContext->MagicQuotes) {
-			_pContext->XMLProtectionMagicQuotes(tokSplit[0]);
-		}
-		node->tag = tokSplit[0];
-		for (size_t i = 1; i < tokSplit.size(); i++) {
-			std::string attributeNM, attributeVal;
-			int mode = 0;
-			for (char ch : tokSplit[i]) {
-				if (ch == '"') {
-					mode++;
-					continue;
-				}
+	_magicQuoteLead[(unsigned char)'&'] = true;
+	for (const std::pair<const std::string, std::string> & pr : MagicQuotesR) {
+		if (pr.first.size() < 2)
+			continue;
+		_magicQuoteLead[(unsigned char)pr.first[0]] = true;
+		_magicQuotes[(unsigned char)pr.first[1]].push_back(pr);
+	}
+}
+
+/** Function to Find the First Character in [pBegin, pEnd) Where a Magic
+  * Quote Could Start. Returns pEnd if There is None.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.1
+  *		- Moved to MagicQuoteDecoder.
+  * Ver : 1.0
+  *		- First Release.
+  */
+const char * MagicQuoteDecoder::FindMagicQuote(const char * pBegin, const char * pEnd) const {
+	while (pBegin != pEnd && !_magicQuoteLead[(unsigned char)*pBegin])
+		++pBegin;
+	return pBegin;
+}
 
-				if (mode == 0)
-					attributeNM.push_back(ch);
-				else  if (mode == 1)
-					attributeVal.push_back(ch);
-				else
+/** Function to Modify String So That Protected XML Files
+  * i.e The One's Whose Tokens are Modified will be Reverted
+  * to Original Value(s). 
+  * More information related to this will be provided in "ReadMe.md"
+  * File.
+  * The String is Decoded in One Pass, In Place (Every Replacement is
+  * Shorter Than its Marker) : Text Between Markers is Moved Down in Blocks
+  * and Each Marker is Looked Up in its Group of _magicQuotes. Numeric
+  * Character References are Decoded to UTF-8. Anything Else is Left As Is.
+  *
+  * Dependant Function(s) - MagicQuoteDecoder::FindMagicQuote, DecodeCharRef
+  * 
+  * Ver : 2.9
+  *		- Moved to MagicQuoteDecoder.
+  * Ver : 2.8
+  *		- Single Pass In Place Decoder (Was One find/replace Loop per Entry).
+  *		- Decodes Numeric Character References.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void MagicQuoteDecoder::XMLProtectionMagicQuotes(std::string & str) const {
+	if (str.empty())
+		return;
+	char * pBegin = &str[0];
+	const char * pEnd = pBegin + str.size();
+	const char * pRead = FindMagicQuote(pBegin, pEnd);
+	char * pWrite = pBegin + (pRead - pBegin);
+	std::string charRef;
+	while (pRead != pEnd) {
+		const std::pair<std::string, std::string> * pMatch = nullptr;
+		if (pRead + 1 != pEnd) {
+			for (const std::pair<std::string, std::string> & pr : _magicQuotes[(unsigned char)pRead[1]]) {
+				if (pr.first[0] == *pRead && pr.first.size() <= (size_t)(pEnd - pRead) &&
+					pr.second.size() <= pr.first.size() &&
+					std::memcmp(pRead, pr.first.data(), pr.first.size()) == 0) {
+					pMatch = &pr;
 					break;
+				}
 			}
-			attributeNM.pop_back();
-			if (_pContext->MagicQuotes) {
-				_pContext->XMLProtectionMagicQuotes(attributeNM);
-				_pContext->XMLProtectionMagicQuotes(attributeVal);
-			}
-			node->attributes.push_back(std::make_pair(attributeNM, attributeVal));
 		}
+		size_t refLength = 0;
+		if (pMatch != nullptr) {
+			std::memcpy(pWrite, pMatch->second.data(), pMatch->second.size());
+			pWrite += pMatch->second.size();
+			pRead += pMatch->first.size();
+		}
+		else if (*pRead == '&' && pRead + 1 != pEnd && pRead[1] == '#' && (refLength = DecodeCharRef(pRead, pEnd, charRef)) != 0) {
+			std::memcpy(pWrite, charRef.data(), charRef.size());
+			pWrite += charRef.size();
+			pRead += refLength;
+		}
+		else {
+			*pWrite++ = *pRead++;
+		}
+		const char * pNext = FindMagicQuote(pRead, pEnd);
+		std::memmove(pWrite, pRead, pNext - pRead);
+		pWrite += pNext - pRead;
+		pRead = pNext;
 	}
-};
+	str.resize(pWrite - pBegin);
+}
 
+/** Function to Set the Current Context.
+  * 
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void State::SetContext(Context * pContext) {
+	_pContext = pContext;
+}
 
-/** State Which will Perform the Functions when the File Stream
-  * Begins with XML Close Tag.
+/** Function to Attach the Input Character Range to the State.
   *
-  * Dependant Class(es) or Structure(s) - State, Context
+  * Dependant Function(s) - N/A
   *
-  * Ver : 2.0
-  *		- Added voidChars Vector. This List will be Used Instead of
-  *		  specialChars to Ignore Storing Characters Into Token Variable.
-  *		- Modified EatChars Function.
-  *	Ver : 1.0
+  * Ver : 2.5
+  *		- Resets What Dfa::Pump Keeps Between Pieces of Fed Input.
+  * Ver : 2.4
+  *		- Resets the Line Count and the Headers (a Reused Toker Does Not
+  *		  Carry Them Over From the Previous Input).
+  * Ver : 2.3
+  *		- Resets the Projection Depths.
+  * Ver : 2.2
+  *		- Resets the Parse Statistics.
+  * Ver : 2.1
+  *		- Takes a Character Range Instead of an istream.
+  * Ver : 1.0
   *		- First Release.
   */
-class EatCloseTag : public State {
-public:
-	EatCloseTag(Context * pContext) { _pContext = pContext; }
-	
-	/** Function to Act Immediately After Transitioning into this
-	  * State.
-	  * This Function Will Simply Keep on Reading Next Character
-	  * Until one of the voidChars Character is Encountered.
-	  *
-	  * Dependant Function(s) - State::CollectChar
-	  *
-	  * Ver : 2.0
-	  *		- Not Using Nodes Anymore.
-	  *		- Scope Variable Changed. Now it Takes Node Pointer.
-	  *		- Uses voidChars now Instead of specialChars.
-	  * Ver : 1.0
-	  *		- First Release.
-	  */
-	virtual void EatChars() {
-		_pContext->token.clear();
-		do {
-			if (!CollectChar())
-				return;
-			if (std::find(voidChars.begin(), voidChars.end(), _pContext->currChar) == voidChars.end())
-				_pContext->token.push_back(_pContext->currChar);
-		} while (_pContext->currChar != '>');
-
-		if (_pContext->MagicQuotes)
-			_pContext->XMLProtectionMagicQuotes(_pContext->token);
-		if (_pContext->token != _pContext->_scope.top()->tag)
-			_pContext->isCorrupt = true;
-		if (_pContext->VERBOSE)
-			std::cout << "\n [VERBOSE] : Popping the Element \"" << _pContext->_scope.top()->tag << "\" from Scope Stack";
-		if (!_pContext->_scope.empty())
-			_pContext->_scope.pop();
-	}
-private:
-	std::vector<char> voidChars = { '<', '>', '/' };
-};
+void State::Attach(const char * pBegin, const char * pEnd) {
+	_pContext->_stats = ParseStats();
+	_pContext->_depth = _pContext->_maxDepth = 0;
+	_pContext->_projectionDepth = _pContext->_matchDepth = 0;
+	_pContext->_lineCount = 0;
+	_pContext->_columnBase = 0;
+	_pContext->prevChar = _pContext->currChar = EOF;
+	_pContext->_version = "1.0";
+	_pContext->_encoding = "UTF-8";
+	_pContext->_pState = _pContext->_pEatHeaders;
+	_pContext->_pBegin = pBegin;
+	_pContext->_pCur = pBegin;
+	_pContext->_pEnd = pEnd;
+	_pContext->_good = true;
+	_pContext->_moreInput = false;
+	_pContext->_scanned = 0;
+	_pContext->_scannedQuote = std::string::npos;
+	_pContext->_pScanFrom = _pContext->_pScanQuote = nullptr;
+}
 
+/** Function to Consume Every Character Up To and Including pLast
+  * (pLast Must be Inside the Input Range). We are Also Updating
+  * prevChar, currChar & lineCount Exactly as if the Characters
+  * Were Read One at a Time.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void State::ConsumeTo(const char * pLast) {
+	const char * pCur = _pContext->_pCur;
+	_pContext->_lineCount += _pContext->_pScan->CountNewlines(pCur, pLast + 1);
+	_pContext->prevChar = pLast > pCur ? (unsigned char)pLast[-1] : _pContext->currChar;
+	_pContext->currChar = (unsigned char)*pLast;
+	_pContext->_pCur = pLast + 1;
+}
 
-/** State Which will Perform the Functions when the File Stream
-  * is the XML Value Field.
+/** Function to Consume the Rest of the Input and Then Hit End of File.
+  * After This CanRead Returns False.
   *
-  * Dependant Class(es) or Structure(s) - State, Context
+  * Dependant Function(s) - N/A
   *
-  * Ver : 2.0
-  *		- Modified EatChars Function.
+  * Ver : 1.1
+  *		- Lines are Not Counted While More Input May Follow (Dfa::Pump
+  *		  Rolls the State Back Anyway).
   * Ver : 1.0
   *		- First Release.
   */
-class EatValue : public State {
-public:
-	EatValue(Context * pContext) { _pContext = pContext; }
-	
-	/** Function to Act Immediately After Transitioning into this
-	* State.
-	* This Function Will Simply Keep on Reading Next Character
-	* Until one of the specialChars Character is Encountered.
-	*
-	* Dependant Function(s) - State::CollectChar, Context::XMLProtectionMagicQuotes
-	*
-	* Ver : 2.0
-	*		- Not Using Nodes Anymore.
-	*		- Scope Variable Changed. Now it Takes Node Pointer.
-	* Ver : 1.0
-	*		-First Release. 
-	*/
-	virtual void EatChars() {
-		_pContext->token.clear();
-		do {
-			if (std::find(specialChars.begin(), specialChars.end(), _pContext->currChar) == specialChars.end())
-				_pContext->token.push_back(_pContext->currChar);
-			if (!CollectChar())
-				return;
-		} while (_pContext->currChar != '<' && (!std::isspace(_pContext->currChar) || _pContext->currChar == ' '));
-		
-		Utilities::StringHelper::Trim(_pContext->token);
-		if (_pContext->MagicQuotes)
-			_pContext->XMLProtectionMagicQuotes(_pContext->token);
-		_pContext->_scope.top()->value = _pContext->token;
+void State::ConsumeAll() {
+	const char * pCur = _pContext->_pCur;
+	const char * pEnd = _pContext->_pEnd;
+	if (!_pContext->_moreInput)
+		_pContext->_lineCount += _pContext->_pScan->CountNewlines(pCur, pEnd);
+	_pContext->prevChar = pEnd > pCur ? (unsigned char)pEnd[-1] : _pContext->currChar;
+	_pContext->currChar = EOF;
+	_pContext->_pCur = pEnd;
+	_pContext->_good = false;
+}
+
+/** Function to Get Where the Search For the End of the Current Token,
+  * Which Would Start at pBegin, Can Start. When Dfa::Pump Runs a State
+  * Again Once More Input Has Arrived, That is Where the Search Got to
+  * Last Time (Context::_pScanFrom, Which a State Moves Forward When its
+  * Search Runs Out of Input).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+const char * State::ScanFrom(const char * pBegin) {
+	const char * pFrom = _pContext->_pScanFrom;
+	return pFrom != nullptr && pFrom > pBegin ? pFrom : pBegin;
+}
+
+/** Function to Set the Current Token to the Characters in [pBegin, pEnd)
+  * Leaving Out the excluded Characters. The Token Refers to the Input
+  * Directly Unless an excluded Character Has to be Removed, in Which Case
+  * the Remaining Characters are Copied Into Context::token.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void State::SetToken(const char * pBegin, const char * pEnd, const std::vector<char> & excluded) {
+	if (std::find_first_of(pBegin, pEnd, excluded.begin(), excluded.end()) == pEnd) {
+		_pContext->tok = Utilities::StringSpan(pBegin, pEnd - pBegin);
+		return;
 	}
-};
+	_pContext->token.clear();
+	for (const char * p = pBegin; p != pEnd; ++p) {
+		if (std::find(excluded.begin(), excluded.end(), *p) == excluded.end())
+			_pContext->token.push_back(*p);
+	}
+	_pContext->tok = Utilities::StringSpan(_pContext->token);
+}
 
-/** State Which will Perform the Functions when the File Stream
-  * is XML Headers.
+/** Function to Find the '>' Closing a Tag Which Starts at pBegin and Set
+  * the Token to the Tag Text (Leaving Out Leading '/' and the excluded
+  * Characters). Returns nullptr if the Tag is Not Closed. The Common Case
+  * (No '<' Before the '>') Keeps the Token as a Span Into the Input.
   *
-  * Dependant Class(es) or Structure(s) - State, Context
+  * Dependant Function(s) - ScanKernels::FindTagDelim, State::ScanFrom, State::SetToken
   *
+  * Ver : 1.1
+  *		- Resumes the Search (State::ScanFrom).
   * Ver : 1.0
   *		- First Release.
   */
-class EatHeaders : public State {
-public:
-	EatHeaders(Context * pContext) { _pContext = pContext; }
-	
-	/** Function to Act Immediately After Transitioning into this
-	  * State.
-	  * This Function Will Simply Keep on Reading Next Character
-	  * Until one of the '>' Character is Encountered.
-	  *
-	  * Dependant Function(s) - State::CollectChar, EatHeaders::SetHeaders
-	  *
-	  * Ver : 1.0
-	  *		- First Release.
-	  */
-	virtual void EatChars() {
-		_pContext->token.clear();
-		bool first = true;
-		do {
-			if (!CollectChar())
-				return;
-			if (first) {
-				first = false;
-				continue;
-			}
-			_pContext->token.push_back(_pContext->currChar);
-		} while (_pContext->currChar != '>');
-		_pContext->token.pop_back();
-		SetHeaders();
+const char * State::FindTagClose(const char * pBegin, const std::vector<char> & excluded) {
+	const char * pEnd = _pContext->_pEnd;
+	const char * pFrom = ScanFrom(pBegin);
+	const char * pClose = _pContext->_pScan->FindTagDelim(pFrom, pEnd);
+	/* What Was Searched Before May Hold a '<' */
+	bool clean = pFrom == pBegin;
+	if (pClose != pEnd && *pClose == '<') {
+		clean = false;
+		pClose = (const char *)std::memchr(pClose, '>', pEnd - pClose);
+		if (pClose == nullptr)
+			pClose = pEnd;
 	}
-private:
-	/** Function to Set XML Header Attributes (Version & Encoding)
-	  * by Evaluating Token in EatHeaders State.
-	  *
-	  * Dependant Function(s) - EatHeaders::RemoveAllWhitespaces, StringHelper::FindSubStr
-	  * 
-	  * Ver : 1.0
-	  *		- First Release.
-	  */
-	void SetHeaders() {
-		std::string nospace = RemoveAllWnitespaces(_pContext->token);
-		int pos = 0;
-		pos = Utilities::StringHelper::FindSubStr(nospace, "version=\"");
-		if (pos != -1) {
-			pos += 9;
-			std::string ver;
-			for (size_t i = pos; nospace[i] != '"'; i++) {
-				ver.push_back(nospace[i]);
+	if (pClose == pEnd) {
+		_pContext->_pScanFrom = pEnd;
+		return nullptr;
+	}
+	while (pBegin != pClose && *pBegin == '/')
+		++pBegin;
+	/* The Kernel Already Ruled Out '<' and '>' */
+	for (size_t i = 0; clean && i < excluded.size(); i++) {
+		if (excluded[i] != '<' && excluded[i] != '>' && std::memchr(pBegin, excluded[i], pClose - pBegin) != nullptr)
+			clean = false;
+	}
+	if (clean)
+		_pContext->tok = Utilities::StringSpan(pBegin, pClose - pBegin);
+	else
+		SetToken(pBegin, pClose, excluded);
+	return pClose;
+}
+
+/** Function to Find the First '<' or '>' From pBegin Which is Not Inside
+  * a Quoted Attribute Value (a '>' May be Written There). A '<' Inside a
+  * Value is Returned (it is Never Allowed), and So is the First Delimiter
+  * After a Quote Which is Never Closed (Unless More Input May Follow, When
+  * the Closing Quote May Still Come). Returns _pEnd if There is None.
+  * Used While Validating.
+  *
+  * Dependant Function(s) - ScanKernels::FindTagDelim, State::ScanFrom
+  *
+  * Ver : 1.2
+  *		- Resumes the Search (State::ScanFrom), Inside a Quoted Value Too
+  *		  (Context::_pScanQuote).
+  * Ver : 1.1
+  *		- Waits For More Input (Context::_moreInput).
+  * Ver : 1.0
+  *		- First Release.
+  */
+const char * State::FindQuotedTagDelim(const char * pBegin) {
+	const char * pEnd = _pContext->_pEnd;
+	const char * pQuote = _pContext->_pScanQuote;
+	pBegin = ScanFrom(pBegin);
+	while (true) {
+		if (pQuote == nullptr) {
+			const char * pDelim = _pContext->_pScan->FindTagDelim(pBegin, pEnd);
+			pQuote = pBegin;
+			while (pQuote != pDelim && *pQuote != '"' && *pQuote != '\'')
+				++pQuote;
+			if (pQuote == pDelim) {
+				if (pDelim == pEnd) {
+					_pContext->_pScanFrom = pEnd;
+					_pContext->_pScanQuote = nullptr;
+				}
+				return pDelim;
 			}
-			_pContext->_version = ver;
-			_pContext->xDoc->setVersion(ver);
+			pBegin = pQuote + 1;
+		}
+		/* Inside the Value Quoted at pQuote, Which is Not Closed Before pBegin */
+		const char * pMatch = (const char *)std::memchr(pBegin, *pQuote, pEnd - pBegin);
+		if (pMatch == nullptr) {
+			if (!_pContext->_moreInput)
+				return _pContext->_pScan->FindTagDelim(pQuote + 1, pEnd);
+			_pContext->_pScanFrom = pEnd;
+			_pContext->_pScanQuote = pQuote;
+			return pEnd;
 		}
+		const char * pLess = (const char *)std::memchr(pQuote + 1, '<', pMatch - (pQuote + 1));
+		if (pLess != nullptr)
+			return pLess;
+		pBegin = pMatch + 1;
+		pQuote = nullptr;
+	}
+}
+
+/** Function to Handle Markup Starting at pOpen Which Runs to the End of
+  * the Input While Validating : if More Input May Follow (Toker::Feed) the
+  * Rest is Consumed so the State Runs Again Once it Has Arrived, Otherwise
+  * it is an Error.
+  *
+  * Dependant Function(s) - State::ConsumeAll, Context::Fail
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void State::NotClosed(const char * pOpen, const std::string & message) {
+	if (_pContext->_moreInput)
+		ConsumeAll();
+	else
+		_pContext->Fail(pOpen, message);
+}
+
+/** Function to Reset the Current Token.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void State::ClearToken() {
+	_pContext->tok = Utilities::StringSpan();
+}
+
+/** Function to Decode Magic Quotes in text (When Enabled). Returns text
+  * Itself When There is Nothing to Decode, Else the Decoded Copy in scratch.
+  *
+  * Dependant Function(s) - MagicQuoteDecoder::FindMagicQuote,
+  *							MagicQuoteDecoder::XMLProtectionMagicQuotes
+  *
+  * Ver : 1.2
+  *		- Uses the Context's MagicQuoteDecoder.
+  * Ver : 1.1
+  *		- Moved From EatOpenTag. Looks For Any Marker Lead Character.
+  * Ver : 1.0
+  *		- First Release.
+  */
+Utilities::StringSpan State::Decode(const Utilities::StringSpan & text, std::string & scratch) {
+	if (!_pContext->MagicQuotes || _pContext->_pMagicQuotes->FindMagicQuote(text.begin(), text.end()) == text.end())
+		return text;
+	scratch.assign(text.data, text.length);
+	_pContext->_pMagicQuotes->XMLProtectionMagicQuotes(scratch);
+	return Utilities::StringSpan(scratch);
+}
+
+/** Function to Convert Character into String.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+State::Token State::makeString(int ch)
+{
+	Token temp;
+	return temp += ch;
+}
+
+/** Function to Record the First Validation Error (Toker::Validate) at pAt
+  * and Stop the Parse. Always Returns False.
+  *
+  * Dependant Function(s) - ScanKernels::CountNewlines
+  *
+  * Ver : 1.1
+  *		- Counts the Columns Feed Has Already Dropped (_columnBase).
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Context::Fail(const char * pAt, const std::string & message) {
+	if (_pError == nullptr || !_pError->message.empty())
+		return false;
+	/* _lineCount Counts the Newlines Before _pCur */
+	size_t line = _lineCount;
+	if (pAt < _pCur)
+		line -= _pScan->CountNewlines(pAt, _pCur);
+	else
+		line += _pScan->CountNewlines(_pCur, pAt);
+	const char * pLine = pAt;
+	while (pLine != _pBegin && pLine[-1] != '\n')
+		--pLine;
+	size_t column = pAt - pLine + 1;
+	if (pLine == _pBegin)
+		column += _columnBase;
+	return Fail(line + 1, column, message);
+}
+
+/** Function to Record the First Validation Error at a Place Already Known
+  * (line and column, From 1) and Stop the Parse. Always Returns False.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Context::Fail(size_t line, size_t column, const std::string & message) {
+	if (_pError == nullptr || !_pError->message.empty())
+		return false;
+	_pError->line = line;
+	_pError->column = column;
+	_pError->message = message;
+	_good = false;
+	return false;
+}
+
+/** Function to Start Checking the Input (Toker::Validate) : Errors Go to
+  * pError and no Element Has Been Seen Yet.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void Context::BeginValidation(ParseError * pError) {
+	_pError = pError;
+	_openTags.clear();
+	_fedTags.clear();
+	_sawElement = false;
+	_moreInput = false;
+}
+
+/** Function to Check at the End of the Input That Every Element Was
+  * Closed and That There Was One. An Element Whose Open Tag Feed Has
+  * Already Dropped is Reported Where _fedTags Says it Started.
+  *
+  * Dependant Function(s) - Context::Fail
+  *
+  * Ver : 1.0
+  *		- First Release (Moved Out of Toker::RunValidation).
+  */
+void Context::ValidateEnd() {
+	if (_pError == nullptr || !_pError->message.empty())
+		return;
+	if (!_openTags.empty()) {
+		const Utilities::StringSpan & tag = _openTags.back();
+		std::string message = "Element <" + tag.str() + "> is Not Closed";
+		if (!_fedTags.empty() && tag.data == _fedTags.back().name.data())
+			Fail(_fedTags.back().line, _fedTags.back().column, message);
+		else
+			Fail(tag.data - 1, message);
+	}
+	else if (!_sawElement)
+		Fail(_pEnd, "No Element Found");
+}
+
+/** Function to Validate Markup Starting With "<!" at pOpen : a Comment,
+  * a CDATA Section or a Declaration Like DOCTYPE (Whose Internal Subset
+  * May Hold '>'). Its Contents are Not Checked. Consumes Up To its End.
+  *
+  * Dependant Function(s) - State::ScanFrom, State::NotClosed, State::ConsumeTo
+  *
+  * Ver : 1.2
+  *		- Resumes the Search For the End of a Comment or CDATA Section
+  *		  (State::ScanFrom).
+  * Ver : 1.1
+  *		- Waits For More Input (State::NotClosed).
+  * Ver : 1.0
+  *		- First Release.
+  */
+void State::ValidateMarkup(const char * pOpen) {
+	const char * pEnd = _pContext->_pEnd;
+	const char * pLast = nullptr;
+	if (pEnd - pOpen >= 4 && std::memcmp(pOpen, "<!--", 4) == 0) {
+		const char * pClose = FindText(ScanFrom(pOpen + 4), pEnd, "-->");
+		if (pClose == nullptr) {
+			/* The "-->" May Start in the Last Two Characters */
+			_pContext->_pScanFrom = pEnd - 2;
+			NotClosed(pOpen, "Comment is Not Closed");
+			return;
+		}
+		pLast = pClose + 2;
+	}
+	else if (pEnd - pOpen >= 9 && std::memcmp(pOpen, "<![CDATA[", 9) == 0) {
+		const char * pClose = FindText(ScanFrom(pOpen + 9), pEnd, "]]>");
+		if (pClose == nullptr) {
+			_pContext->_pScanFrom = pEnd - 2;
+			NotClosed(pOpen, "CDATA Section is Not Closed");
+			return;
+		}
+		pLast = pClose + 2;
+	}
+	else {
+		bool inSubset = false;
+		for (const char * p = pOpen + 2; p != pEnd && pLast == nullptr; ++p) {
+			if (*p == '[')
+				inSubset = true;
+			else if (*p == ']')
+				inSubset = false;
+			else if (*p == '>' && !inSubset)
+				pLast = p;
+		}
+		if (pLast == nullptr) {
+			NotClosed(pOpen, "Declaration is Not Closed");
+			return;
+		}
+	}
+	ConsumeTo(pLast);
+}
+
+/** Function to Validate the Open Tag in [pOpen, pClose] ('<' to '>') and
+  * Push its Name onto Context::_openTags (Unless it Closes Itself). Only
+  * One Element May be at the Top Level. While More Input May Follow the
+  * Name is Copied to Context::_fedTags With its Line and Column, as Feed
+  * Drops the Input. The Column is Counted From the Last Tag Copied
+  * (_pColumnAnchor) Unless a Newline Comes Between.
+  *
+  * Dependant Function(s) - State::ValidateAttributes, Context::Fail
+  *
+  * Ver : 1.2
+  *		- Copies the Name While More Input May Follow (Context::_fedTags).
+  * Ver : 1.1
+  *		- Rejects a Second Root Element.
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool State::ValidateStartTag(const char * pOpen, const char * pClose) {
+	const char * p = pOpen + 1;
+	if (p == pClose || !IsNameStart((unsigned char)*p))
+		return _pContext->Fail(p, "Missing or Invalid Tag Name");
+	if (_pContext->_sawElement && _pContext->_openTags.empty())
+		return _pContext->Fail(pOpen, "More Than One Root Element");
+	const char * pName = p;
+	while (p != pClose && IsNameChar((unsigned char)*p))
+		++p;
+	Utilities::StringSpan name(pName, p - pName);
+	bool selfClosing = pClose[-1] == '/' && pClose - 1 >= p;
+	if (!ValidateAttributes(p, selfClosing ? pClose - 1 : pClose))
+		return false;
+	_pContext->_sawElement = true;
+	if (selfClosing)
+		return true;
+	if (!_pContext->_moreInput) {
+		_pContext->_openTags.push_back(name);
+		return true;
+	}
+	Context::FedTag tag;
+	tag.name.assign(name.data, name.length);
+	tag.line = _pContext->_lineCount - _pContext->_pScan->CountNewlines(pOpen, _pContext->_pCur) + 1;
+	const char * pAnchor = _pContext->_pColumnAnchor != nullptr ? _pContext->_pColumnAnchor : _pContext->_pBegin;
+	const char * pLine = pOpen;
+	while (pLine != pAnchor && pLine[-1] != '\n')
+		--pLine;
+	if (pLine != pAnchor)
+		tag.column = pOpen - pLine + 1;
+	else if (_pContext->_pColumnAnchor != nullptr)
+		tag.column = _pContext->_anchorColumn + (pOpen - pAnchor);
+	else
+		tag.column = _pContext->_columnBase + (pOpen - pAnchor) + 1;
+	_pContext->_pColumnAnchor = pOpen;
+	_pContext->_anchorColumn = tag.column;
+	_pContext->_fedTags.push_back(tag);
+	_pContext->_openTags.push_back(Utilities::StringSpan(_pContext->_fedTags.back().name));
+	return true;
+}
+
+/** Function to Validate the Attributes in [p, pEnd) : Each Must be
+  * Preceded by Whitespace and Written name="value" or name='value', and
+  * no Name May Repeat. The Attributes are Left in Context::_attributeSpans.
+  *
+  * Dependant Function(s) - Context::Fail
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool State::ValidateAttributes(const char * p, const char * pEnd) {
+	std::vector<std::pair<Utilities::StringSpan, Utilities::StringSpan>> & attributes = _pContext->_attributeSpans;
+	attributes.clear();
+	while (true) {
+		const char * pSpace = p;
+		while (p != pEnd && IsSpace((unsigned char)*p))
+			++p;
+		if (p == pEnd)
+			return true;
+		if (p == pSpace)
+			return _pContext->Fail(p, "Missing Whitespace Before Attribute");
+		if (!IsNameStart((unsigned char)*p))
+			return _pContext->Fail(p, "Invalid Attribute Name");
+		const char * pName = p;
+		while (p != pEnd && IsNameChar((unsigned char)*p))
+			++p;
+		Utilities::StringSpan name(pName, p - pName);
+		while (p != pEnd && IsSpace((unsigned char)*p))
+			++p;
+		if (p == pEnd || *p != '=')
+			return _pContext->Fail(p, "Attribute \"" + name.str() + "\" Has No Value");
+		++p;
+		while (p != pEnd && IsSpace((unsigned char)*p))
+			++p;
+		if (p == pEnd || (*p != '"' && *p != '\''))
+			return _pContext->Fail(p, "Value of Attribute \"" + name.str() + "\" is Not Quoted");
+		const char * pQuote = (const char *)std::memchr(p + 1, *p, pEnd - (p + 1));
+		if (pQuote == nullptr)
+			return _pContext->Fail(p, "Value of Attribute \"" + name.str() + "\" is Not Closed");
+		for (const std::pair<Utilities::StringSpan, Utilities::StringSpan> & attribute : attributes) {
+			if (SameText(attribute.first, name))
+				return _pContext->Fail(pName, "Duplicate Attribute \"" + name.str() + "\"");
+		}
+		attributes.push_back(std::make_pair(name, Utilities::StringSpan(p + 1, pQuote - (p + 1))));
+		p = pQuote + 1;
+	}
+}
+
+/** Function to Validate the Processing Instruction in [pOpen, pClose]
+  * ("<?" to '>'). Only the XML Declaration is Checked Further : it Must
+  * Come First (After an Optional UTF-8 BOM), Hold version="1.x", Then
+  * Optionally encoding and standalone (yes / no), in That Order. Where it
+  * Comes Counts the Bytes Feed Has Already Dropped (ParseStats::bytes).
+  *
+  * Dependant Function(s) - State::ValidateAttributes, Context::Fail
+  *
+  * Ver : 1.1
+  *		- Works on Fed Input.
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool State::ValidateProcessingInstruction(const char * pOpen, const char * pClose) {
+	const char * p = pOpen + 2;
+	if (pClose == p || pClose[-1] != '?')
+		return _pContext->Fail(pClose, "Processing Instruction Does Not End With \"?>\"");
+	const char * pEnd = pClose - 1;
+	const char * pTarget = p;
+	while (p < pEnd && IsNameChar((unsigned char)*p))
+		++p;
+	if (p == pTarget || !IsNameStart((unsigned char)*pTarget))
+		return _pContext->Fail(pTarget, "Processing Instruction Has No Target");
+	if (p - pTarget != 3 || std::memcmp(pTarget, "xml", 3) != 0)
+		return true;
+
+	const char * pBegin = _pContext->_pBegin;
+	if (_pContext->_stats.bytes != 0 ||
+		(pOpen != pBegin && !(pOpen == pBegin + 3 && std::memcmp(pBegin, "\xEF\xBB\xBF", 3) == 0)))
+		return _pContext->Fail(pOpen, "XML Declaration is Not at the Start of the Input");
+	if (!ValidateAttributes(p, pEnd))
+		return false;
+	static const char * names[] = { "version", "encoding", "standalone" };
+	size_t next = 0;
+	for (const std::pair<Utilities::StringSpan, Utilities::StringSpan> & attribute : _pContext->_attributeSpans) {
+		while (next < 3 && attribute.first != names[next])
+			next++;
+		if (next == 3)
+			return _pContext->Fail(attribute.first.data, "\"" + attribute.first.str() + "\" is Unexpected or Out of Order in the XML Declaration");
+		const Utilities::StringSpan & value = attribute.second;
+		bool good = true;
+		if (next == 0) {
+			good = value.length > 2 && value.data[0] == '1' && value.data[1] == '.';
+			for (size_t i = 2; good && i < value.length; i++)
+				good = (unsigned)(value.data[i] - '0') < 10;
+		}
+		else if (next == 1) {
+			good = value.length > 0 && (unsigned)((value.data[0] | 0x20) - 'a') < 26;
+			for (size_t i = 1; good && i < value.length; i++)
+				good = IsNameChar((unsigned char)value.data[i]) && value.data[i] != ':';
+		}
+		else {
+			good = value == "yes" || value == "no";
+		}
+		if (!good)
+			return _pContext->Fail(value.data, "Invalid " + attribute.first.str() + " \"" + value.str() + "\" in the XML Declaration");
+		next++;
+	}
+	if (_pContext->_attributeSpans.empty() || _pContext->_attributeSpans.front().first != "version")
+		return _pContext->Fail(pTarget, "XML Declaration Has No version");
+	return true;
+}
+
+/** Function to Validate the Close Tag in [pOpen, pClose] ("</" to '>')
+  * Against the Innermost Open Tag and Pop it (and its Copy in
+  * Context::_fedTags, if Any).
+  *
+  * Dependant Function(s) - Context::Fail
+  *
+  * Ver : 1.1
+  *		- Also Pops Context::_fedTags.
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool State::ValidateEndTag(const char * pOpen, const char * pClose) {
+	const char * pName = pOpen + 2;
+	const char * p = pName;
+	if (p == pClose || !IsNameStart((unsigned char)*p))
+		return _pContext->Fail(p, "Missing or Invalid Tag Name");
+	while (p != pClose && IsNameChar((unsigned char)*p))
+		++p;
+	Utilities::StringSpan name(pName, p - pName);
+	while (p != pClose && IsSpace((unsigned char)*p))
+		++p;
+	if (p != pClose)
+		return _pContext->Fail(p, "Unexpected Character in Close Tag");
+	std::vector<Utilities::StringSpan> & openTags = _pContext->_openTags;
+	if (openTags.empty())
+		return _pContext->Fail(pOpen, "Close Tag </" + name.str() + "> Has No Open Tag");
+	if (!SameText(openTags.back(), name))
+		return _pContext->Fail(pOpen, "Close Tag </" + name.str() + "> Does Not Match <" + openTags.back().str() + ">");
+	std::deque<Context::FedTag> & fedTags = _pContext->_fedTags;
+	if (!fedTags.empty() && openTags.back().data == fedTags.back().name.data())
+		fedTags.pop_back();
+	openTags.pop_back();
+	return true;
+}
+
+/** Function to Decide Whether an Open Tag Read While Projecting
+  * (Toker::SetProjection) is Reported. Inside a Matching Element Everything
+  * is. Otherwise the Tag Takes the Next Step of Each Pattern Still Matching
+  * its Ancestors : if a Pattern Ends There the Element Matches, if Some
+  * Pattern Continues it is Reported as an Ancestor. Returns False (Nothing
+  * Changed) if No Pattern Can Match Inside the Element.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Context::Project(const Utilities::StringSpan & tag) {
+	if (_matchDepth > 0) {
+		_matchDepth++;
+		return true;
+	}
+	const std::vector<std::vector<std::string>> & patterns = *_pProjection;
+	size_t level = _projectionDepth;
+	if (_projectionAlive.size() < level + 2)
+		_projectionAlive.resize(level + 2);
+	std::vector<unsigned> & next = _projectionAlive[level + 1];
+	next.clear();
+	size_t count = level == 0 ? patterns.size() : _projectionAlive[level].size();
+	for (size_t i = 0; i < count; i++) {
+		unsigned index = level == 0 ? (unsigned)i : _projectionAlive[level][i];
+		const std::string & step = patterns[index][level];
+		if (step != "*" && tag != step)
+			continue;
+		if (patterns[index].size() == level + 1) {
+			_matchDepth = 1;
+			return true;
+		}
+		next.push_back(index);
+	}
+	if (next.empty())
+		return false;
+	_projectionDepth++;
+	return true;
+}
+
+/** Function to Transition Into Next State. Here
+  * we Analyze the Current and/or Previous and/or
+  * Next Character to Select the Next State. 
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 2.2
+  *		- Transitions are Traced (XML_TRACE) Instead of VERBOSE Output.
+  * Ver : 2.1
+  *		- Peeks Directly Into the Input Range.
+  * Ver : 2.0
+  *		- Added VERBOSE Mode Support.
+  * Ver : 1.0
+  *		- First Release.
+  */
+State* State::NextState()
+{
+	if (!_pContext->_good)
+	{
+		return nullptr;
+	}
+	int chNext = _pContext->_pCur < _pContext->_pEnd ? (unsigned char)*_pContext->_pCur : EOF;
+	
+	/* The following tests must come first */
+	if (_pContext->currChar == '<' && chNext == '?')
+	{
+		XML_TRACE_STATE(_pContext, TraceEvent::Headers);
+		return _pContext->_pEatHeaders;
+	}
+	if (_pContext->currChar == '<' && chNext != '/')
+	{
+		XML_TRACE_STATE(_pContext, TraceEvent::OpenTag);
+		return _pContext->_pEatOpenTag;
+	}
+	if (_pContext->currChar == '<' && chNext == '/')
+	{
+		XML_TRACE_STATE(_pContext, TraceEvent::CloseTag);
+		return _pContext->_pEatCloseTag;
+	}
+	if (std::isspace(_pContext->currChar))
+	{
+		XML_TRACE_STATE(_pContext, TraceEvent::Whitespace);
+		return _pContext->_pEatWhitespace;
+	}
+	if (!std::isspace(_pContext->currChar) && _pContext->currChar != '>')
+	{
+		XML_TRACE_STATE(_pContext, TraceEvent::Value);
+		return _pContext->_pEatValue;
+	}
+	if (!_pContext->_good)
+	{
+		XML_TRACE_STATE(_pContext, TraceEvent::Whitespace);
+		return _pContext->_pEatWhitespace;
+	}
+	
+	/* If _pContext->currChar is not a state transition char
+	 * then send it to Eat Value State.
+	 */
+	return _pContext->_pEatWhitespace;
+}
+
+/** State Which will Perform the Functions when the File Stream
+  * Characters are Whitespace(s).
+  *
+  * Dependant Class(es) or Structure(s) - State, Context
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+class EatWhitespace : public State {
+public:
+	EatWhitespace(Context * pContext) { _pContext = pContext; _id = TraceEvent::Whitespace; }
+	
+	/** Function to Act Immediately After Transitioning into this
+	  * State.
+	  * This Function Will Simply Skip Characters Until a
+	  * Non-Whitespace Character is Encountered.
+	  *
+	  * Dependant Function(s) - ScanKernels::SkipWhitespace, State::ScanFrom,
+	  *							State::ConsumeTo, State::ConsumeAll
+	  * 
+	  * Ver : 2.3
+	  *		- Resumes the Scan (State::ScanFrom).
+	  * Ver : 2.2
+	  *		- Uses the SkipWhitespace Scanning Kernel.
+	  * Ver : 2.1
+	  *		- Scans the Input Range Instead of Collecting Characters.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	virtual void EatChars() {
+		ClearToken();
+		if (!_pContext->_good)
+			return;
+		const char * pEnd = _pContext->_pEnd;
+		const char * p = _pContext->_pScan->SkipWhitespace(ScanFrom(_pContext->_pCur), pEnd);
+		if (p != pEnd)
+			ConsumeTo(p);
+		else {
+			_pContext->_pScanFrom = pEnd;
+			ConsumeAll();
+		}
+	}
+};
+
+/** State Which will Perform the Functions when the File Stream
+  * Begins with XML Open Tag.
+  *
+  * Dependant Class(es) or Structure(s) - State, Context
+  *
+  * Ver : 2.0
+  *		- Removed TagHelper Function. No Longer Needed.
+  * Ver : 1.0
+  *		- First Release.
+  */
+class EatOpenTag : public State {
+public:
+	EatOpenTag(Context * pContext) { _pContext = pContext; _id = TraceEvent::OpenTag; }
+	
+	/** Function to Act Immediately After Transitioning into this
+	* State.
+	* The Token is Everything Up To the Closing '>' (Leaving Out 
+	* specialChars).
+	*
+	* Dependant Function(s) - State::FindTagClose, State::ConsumeTo, EatOpenTag::ReportStartTag
+	*
+	* Ver : 2.6
+	*		- Elements Outside the Projection are Skipped (See ReportStartTag).
+	* Ver : 2.5
+	*		- Only Validates the Tag While Validating (Toker::Validate).
+	* Ver : 2.4
+	*		- Reports the Tag to the ParseHandler Instead of Creating a Node.
+	* Ver : 2.2
+	*		- Uses the FindTagDelim Scanning Kernel (Through FindTagClose).
+	* Ver : 2.1
+	*		- Scans the Input Range For '>' Instead of Collecting Characters.
+	* Ver : 2.0
+	*		- Not Using Nodes Anymore.
+	*		- Scope Variable Changed. Now it Takes Node Pointer.
+	*/
+	virtual void EatChars() {
+		ClearToken();
+		if (!_pContext->_good)
+			return;
+		if (_pContext->_pError != nullptr) {
+			Validate();
+			return;
+		}
+		const char * pClose = FindTagClose(_pContext->_pCur, specialChars);
+		if (pClose == nullptr) {
+			ConsumeAll();
+			return;
+		}
+		ConsumeTo(pClose);
+
+		if (HasTok())
+			ReportStartTag();
+	}
+private:
+	/** Function to Validate the Open Tag (or "<!" Markup) Starting at the
+	  * '<' Just Read. Nothing is Reported to the ParseHandler.
+	  *
+	  * Dependant Function(s) - State::ValidateMarkup, State::FindQuotedTagDelim,
+	  *							State::ValidateStartTag, State::NotClosed, Context::Fail
+	  *
+	  * Ver : 1.2
+	  *		- Waits For More Input (State::NotClosed).
+	  * Ver : 1.1
+	  *		- A '>' in a Quoted Attribute Value Does Not End the Tag.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void Validate() {
+		const char * pOpen = _pContext->_pCur - 1;
+		if (_pContext->_pCur != _pContext->_pEnd && *_pContext->_pCur == '!') {
+			ValidateMarkup(pOpen);
+			return;
+		}
+		const char * pClose = FindQuotedTagDelim(_pContext->_pCur);
+		if (pClose == _pContext->_pEnd) {
+			NotClosed(pOpen, "Tag is Not Closed");
+			return;
+		}
+		if (*pClose == '<') {
+			_pContext->Fail(pClose, "'<' Inside a Tag");
+			return;
+		}
+		ConsumeTo(pClose);
+		ValidateStartTag(pOpen, pClose);
+	}
+
+	/** Funtion to Report the Open Tag to the ParseHandler. This Method will
+	  * Process Open Tag State Token to Get Tag Name and it's Associated Attributes
+	  * and Reports Them as StartElement Followed by One Attribute per Attribute.
+	  * The Token is Lexed in One Pass and the Names and Values are Reported as
+	  * Spans Into it :
+	  *		- Tag Name and Attributes are Separated by Whitespace.
+	  *		- Attribute is name="value", name='value' (Quoted Values May Hold
+	  *		  Whitespace), name=value or Just name (Empty Value).
+	  *		- A Lone '/' (Self Closing Tag) is Not an Attribute.
+	  * With MagicQuotes the Decoded Text Goes Through Context Scratch Strings.
+	  * With Lazy Values (Context::_lazyValues) Attribute Values are Left Undecoded.
+	  * While Projecting, an Element No Pattern Can Match is Skipped Instead.
+	  *
+	  * Dependant Function(s) - State::Decode, Context::Project, EatOpenTag::SkipElement,
+	  *							ParseHandler::StartElement, ParseHandler::Attribute
+	  *
+	  * Ver : 2.6
+	  *		- Skips Elements Outside the Projection (Toker::SetProjection).
+	  * Ver : 2.5
+	  *		- Single Pass Lexer Over the Token (No Split, No Per Character
+	  *		  Copies). Handles Quoted Values Containing Whitespace.
+	  * Ver : 2.4
+	  *		- Renamed From SetNodeInfo. Reports to the ParseHandler Instead of
+	  *		  Filling a Node.
+	  * Ver : 2.0
+	  *		- Added VERBOSE Mode Feature.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void ReportStartTag() {
+		const char * p = _pContext->tok.begin();
+		const char * pEnd = _pContext->tok.end();
+		while (p != pEnd && IsSpace((unsigned char)*p))
+			++p;
+		const char * pTag = p;
+		while (p != pEnd && !IsSpace((unsigned char)*p))
+			++p;
+		Utilities::StringSpan tag(pTag, p - pTag);
+		Utilities::StringSpan name = Decode(tag, _pContext->_scratchName);
+		if (_pContext->_pProjection != nullptr && !_pContext->Project(name)) {
+			if (*pTag != '!' && pEnd[-1] != '/')
+				SkipElement();
+			return;
+		}
+		_pContext->CountStartElement(tag);
+		_pContext->_pHandler->StartElement(name);
+
+		while (true) {
+			while (p != pEnd && IsSpace((unsigned char)*p))
+				++p;
+			if (p == pEnd)
+				break;
+			const char * pName = p;
+			while (p != pEnd && *p != '=' && !IsSpace((unsigned char)*p))
+				++p;
+			Utilities::StringSpan name(pName, p - pName);
+			Utilities::StringSpan value;
+
+			const char * q = p;
+			while (q != pEnd && IsSpace((unsigned char)*q))
+				++q;
+			if (q != pEnd && *q == '=') {
+				++q;
+				while (q != pEnd && IsSpace((unsigned char)*q))
+					++q;
+				const char * pValue = q;
+				if (q != pEnd && (*q == '"' || *q == '\'')) {
+					const char * pClose = (const char *)std::memchr(q + 1, *q, pEnd - (q + 1));
+					pValue = q + 1;
+					q = pClose == nullptr ? pEnd : pClose;
+					value = Utilities::StringSpan(pValue, q - pValue);
+					if (q != pEnd)
+						++q;
+				}
+				else {
+					while (q != pEnd && !IsSpace((unsigned char)*q))
+						++q;
+					value = Utilities::StringSpan(pValue, q - pValue);
+				}
+				p = q;
+			}
+			else if (name.length == 1 && *pName == '/') {
+				continue;
+			}
+			_pContext->CountAttribute(name, value);
+			if (!_pContext->_lazyValues)
+				value = Decode(value, _pContext->_scratchValue);
+			_pContext->_pHandler->Attribute(Decode(name, _pContext->_scratchName), value);
+		}
+	}
+
+	/** Function to Skip Everything Inside the Element Whose Open Tag Was
+	  * Just Read, Up To and Including its Close Tag. Nothing is Reported or
+	  * Copied : the Scan Jumps From One '<' to the Next and Only Counts Open
+	  * and Close Tags. Comments, CDATA Sections and Processing Instructions
+	  * are Passed Over Whole; Self Closing Tags do Not Nest.
+	  *
+	  * Dependant Function(s) - State::ConsumeTo, State::ConsumeAll
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void SkipElement() {
+		const char * pEnd = _pContext->_pEnd;
+		const char * p = _pContext->_pCur;
+		size_t depth = 1;
+		while ((p = (const char *)std::memchr(p, '<', pEnd - p)) != nullptr) {
+			const char * pLast = nullptr;
+			if (pEnd - p >= 4 && std::memcmp(p, "<!--", 4) == 0) {
+				if ((pLast = FindText(p + 4, pEnd, "-->")) != nullptr)
+					pLast += 2;
+			}
+			else if (pEnd - p >= 9 && std::memcmp(p, "<![CDATA[", 9) == 0) {
+				if ((pLast = FindText(p + 9, pEnd, "]]>")) != nullptr)
+					pLast += 2;
+			}
+			else if (pEnd - p >= 2 && p[1] == '?') {
+				if ((pLast = FindText(p + 2, pEnd, "?>")) != nullptr)
+					pLast += 1;
+			}
+			else
+				pLast = (const char *)std::memchr(p + 1, '>', pEnd - (p + 1));
+			if (pLast == nullptr)
+				break;
+
+			if (p[1] == '/') {
+				if (--depth == 0) {
+					ConsumeTo(pLast);
+					return;
+				}
+			}
+			else if (p[1] != '!' && p[1] != '?' && pLast[-1] != '/')
+				depth++;
+			p = pLast + 1;
+		}
+		ConsumeAll();
+	}
+};
+
+
+/** State Which will Perform the Functions when the File Stream
+  * Begins with XML Close Tag.
+  *
+  * Dependant Class(es) or Structure(s) - State, Context
+  *
+  * Ver : 2.0
+  *		- Added voidChars Vector. This List will be Used Instead of
+  *		  specialChars to Ignore Storing Characters Into Token Variable.
+  *		- Modified EatChars Function.
+  *	Ver : 1.0
+  *		- First Release.
+  */
+class EatCloseTag : public State {
+public:
+	EatCloseTag(Context * pContext) { _pContext = pContext; _id = TraceEvent::CloseTag; }
+	
+	/** Function to Act Immediately After Transitioning into this
+	  * State.
+	  * The Token is Everything Up To the Closing '>' (Leaving Out
+	  * voidChars).
+	  *
+	  * Dependant Function(s) - State::FindTagClose, State::ScanFrom, State::ConsumeTo,
+	  *							State::Decode, ParseHandler::EndElement
+	  *
+	  * Ver : 2.8
+	  *		- Resumes the Search For the '>' While Validating (State::ScanFrom).
+	  * Ver : 2.7
+	  *		- Keeps Track of the Projection Depths (Toker::SetProjection).
+	  * Ver : 2.6
+	  *		- Only Validates the Tag While Validating (Toker::Validate).
+	  * Ver : 2.5
+	  *		- Token is Only Copied When it Holds a Magic Quote.
+	  * Ver : 2.4
+	  *		- Reports the Tag to the ParseHandler (Scope Check Moved to
+	  *		  DocumentBuilder::EndElement).
+	  * Ver : 2.2
+	  *		- Uses the FindTagDelim Scanning Kernel (Through FindTagClose).
+	  * Ver : 2.1
+	  *		- Scans the Input Range For '>' Instead of Collecting Characters.
+	  *		  The Leading '/' is Skipped so the Token Can Refer to the Input.
+	  * Ver : 2.0
+	  *		- Not Using Nodes Anymore.
+	  *		- Scope Variable Changed. Now it Takes Node Pointer.
+	  *		- Uses voidChars now Instead of specialChars.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	virtual void EatChars() {
+		ClearToken();
+		if (!_pContext->_good)
+			return;
+		if (_pContext->_pError != nullptr) {
+			const char * pOpen = _pContext->_pCur - 1;
+			const char * pClose = _pContext->_pScan->FindTagDelim(ScanFrom(_pContext->_pCur), _pContext->_pEnd);
+			if (pClose == _pContext->_pEnd) {
+				_pContext->_pScanFrom = pClose;
+				NotClosed(pOpen, "Tag is Not Closed");
+			}
+			else if (*pClose == '<')
+				_pContext->Fail(pClose, "'<' Inside a Tag");
+			else {
+				ConsumeTo(pClose);
+				ValidateEndTag(pOpen, pClose);
+			}
+			return;
+		}
+		const char * pClose = FindTagClose(_pContext->_pCur, voidChars);
+		if (pClose == nullptr) {
+			ConsumeAll();
+			return;
+		}
+		ConsumeTo(pClose);
+
+		_pContext->tok = Decode(_pContext->tok, _pContext->token);
+		_pContext->_depth--;
+		if (_pContext->_pProjection != nullptr)
+			_pContext->ProjectEnd();
+		_pContext->_pHandler->EndElement(_pContext->tok);
+	}
+private:
+	std::vector<char> voidChars = { '<', '>', '/' };
+};
+
+
+/** State Which will Perform the Functions when the File Stream
+  * is the XML Value Field.
+  *
+  * Dependant Class(es) or Structure(s) - State, Context
+  *
+  * Ver : 2.0
+  *		- Modified EatChars Function.
+  * Ver : 1.0
+  *		- First Release.
+  */
+class EatValue : public State {
+public:
+	EatValue(Context * pContext) { _pContext = pContext; _id = TraceEvent::Value; }
+	
+	/** Function to Act Immediately After Transitioning into this
+	* State.
+	* The Token Starts at the Current Character and Runs Until '<'
+	* or a Whitespace Other Than ' ' (Leaving Out specialChars).
+	*
+	* Dependant Function(s) - ScanKernels::FindValueStop, State::ScanFrom, State::SetToken,
+	*							State::ConsumeTo, State::Decode, ParseHandler::Text
+	*
+	* Ver : 2.9
+	*		- Resumes the Scan (State::ScanFrom).
+	* Ver : 2.8
+	*		- Text Outside the Root Element Fails Validation.
+	* Ver : 2.7
+	*		- Value is Not Reported While Validating (Toker::Validate).
+	* Ver : 2.6
+	*		- Value is Left Undecoded With Lazy Values (Context::_lazyValues).
+	* Ver : 2.5
+	*		- Token is Only Copied When it Holds a Magic Quote.
+	* Ver : 2.4
+	*		- Reports the Value to the ParseHandler.
+	* Ver : 2.2
+	*		- Uses the FindValueStop Scanning Kernel. A '>' Inside the Value
+	*		  (Which Has to be Left Out) Resumes the Scan.
+	* Ver : 2.1
+	*		- Scans the Input Range Instead of Collecting Characters. The Value
+	*		  is Copied Once, Straight From the Input Into the Node.
+	*		- Dropped the Trim Call (its Result Was Never Used).
+	* Ver : 2.0
+	*		- Not Using Nodes Anymore.
+	*		- Scope Variable Changed. Now it Takes Node Pointer.
+	* Ver : 1.0
+	*		-First Release. 
+	*/
+	virtual void EatChars() {
+		ClearToken();
+		const char * pEnd = _pContext->_pEnd;
+		const char * pStart = _pContext->_pCur - 1;
+		const char * pFrom = ScanFrom(_pContext->_pCur);
+		const char * p = _pContext->_pScan->FindValueStop(pFrom, pEnd);
+		/* What Was Scanned Before May Hold a '>' */
+		bool excluded = pFrom != _pContext->_pCur;
+		while (p != pEnd && *p == '>') {
+			excluded = true;
+			p = _pContext->_pScan->FindValueStop(p + 1, pEnd);
+		}
+		if (_pContext->_pError != nullptr && _pContext->_openTags.empty()) {
+			const char * pText = _pContext->_pScan->SkipWhitespace(pStart, p);
+			if (pText != p) {
+				_pContext->Fail(pText, _pContext->_sawElement ? "Text After the Root Element" : "Text Before the First Tag");
+				return;
+			}
+		}
+		if (p == pEnd) {
+			_pContext->_pScanFrom = pEnd;
+			ConsumeAll();
+			return;
+		}
+		if (excluded)
+			SetToken(pStart, p, specialChars);
+		else
+			_pContext->tok = Utilities::StringSpan(pStart, p - pStart);
+		ConsumeTo(p);
+		if (_pContext->_pError != nullptr)
+			return;
+
+		_pContext->_stats.bytesAllocated += _pContext->tok.length;
+		if (!_pContext->_lazyValues)
+			_pContext->tok = Decode(_pContext->tok, _pContext->token);
+		_pContext->_pHandler->Text(_pContext->tok);
+	}
+};
+
+/** State Which will Perform the Functions when the File Stream
+  * is XML Headers.
+  *
+  * Dependant Class(es) or Structure(s) - State, Context
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+class EatHeaders : public State {
+public:
+	EatHeaders(Context * pContext) { _pContext = pContext; _id = TraceEvent::Headers; }
+	
+	/** Function to Act Immediately After Transitioning into this
+	  * State.
+	  * The Token is Everything After the First Character Up To
+	  * the Closing '>'.
+	  *
+	  * Dependant Function(s) - State::ScanFrom, State::ConsumeTo, EatHeaders::SetHeaders,
+	  *							EatHeaders::Validate
+	  *
+	  * Ver : 2.3
+	  *		- Resumes the Search For the '>' (State::ScanFrom).
+	  * Ver : 2.2
+	  *		- Only Validates the Header While Validating (Toker::Validate).
+	  * Ver : 2.1
+	  *		- Scans the Input Range For '>' Instead of Collecting Characters.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	virtual void EatChars() {
+		ClearToken();
+		if (!_pContext->_good)
+			return;
+		if (_pContext->_pError != nullptr) {
+			Validate();
+			return;
+		}
+		if (_pContext->_pCur == _pContext->_pEnd) {
+			ConsumeAll();
+			return;
+		}
+		/* First Character is Skipped */
+		ConsumeTo(_pContext->_pCur);
+		if (_pContext->currChar == '>')
+			return;
+
+		const char * pCur = _pContext->_pCur;
+		const char * pFrom = ScanFrom(pCur);
+		const char * pClose = (const char *)std::memchr(pFrom, '>', _pContext->_pEnd - pFrom);
+		if (pClose == nullptr) {
+			_pContext->_pScanFrom = _pContext->_pEnd;
+			ConsumeAll();
+			return;
+		}
+		_pContext->tok = Utilities::StringSpan(pCur, pClose - pCur);
+		ConsumeTo(pClose);
+		SetHeaders();
+	}
+private:
+	/** Function to Validate a Processing Instruction. At the Start of the
+	  * Input it First Skips a UTF-8 BOM and Whitespace, and if Something
+	  * Other Than "<?" Follows, Only Consumes Up To its '<' so the Next
+	  * State Reads it (Unlike Parsing, a Document Without an XML
+	  * Declaration is Accepted).
+	  *
+	  * Dependant Function(s) - State::ValidateProcessingInstruction, State::ScanFrom,
+	  *							State::NotClosed, Context::Fail
+	  *
+	  * Ver : 1.2
+	  *		- Resumes the Search For the '>' (State::ScanFrom).
+	  * Ver : 1.1
+	  *		- Waits For More Input (State::NotClosed).
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void Validate() {
+		const char * pEnd = _pContext->_pEnd;
+		const char * pOpen = _pContext->_pCur - 1;
+		if (_pContext->_pCur == _pContext->_pBegin) {
+			const char * p = _pContext->_pBegin;
+			if (pEnd - p >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0)
+				p += 3;
+			p = _pContext->_pScan->SkipWhitespace(p, pEnd);
+			if (p == pEnd) {
+				ConsumeAll();
+				return;
+			}
+			if (*p != '<') {
+				_pContext->Fail(p, "Text Before the First Tag");
+				return;
+			}
+			if (pEnd - p < 2 || p[1] != '?') {
+				ConsumeTo(p);
+				return;
+			}
+			pOpen = p;
+		}
+		const char * pFrom = ScanFrom(pOpen + 2);
+		const char * pClose = (const char *)std::memchr(pFrom, '>', pEnd - pFrom);
+		if (pClose == nullptr) {
+			_pContext->_pScanFrom = pEnd;
+			NotClosed(pOpen, "Processing Instruction is Not Closed");
+			return;
+		}
+		ConsumeTo(pClose);
+		ValidateProcessingInstruction(pOpen, pClose);
+	}
+
+	/** Function to Set XML Header Attributes (Version & Encoding)
+	  * by Evaluating Token in EatHeaders State.
+	  *
+	  * Dependant Function(s) - EatHeaders::RemoveAllWhitespaces, StringHelper::FindSubStr,
+	  *							ParseHandler::Declaration
+	  * 
+	  * Ver : 2.6
+	  *		- Transcoded Input Reports UTF-8 (What the Values are Now In).
+	  * Ver : 2.5
+	  *		- Works in Context::_scratchValue and Assigns the Headers in Place
+	  *		  (No Temporary Strings).
+	  * Ver : 2.4
+	  *		- Reports Version & Encoding to the ParseHandler.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void SetHeaders() {
+		std::string & nospace = _pContext->_scratchValue;
+		RemoveAllWnitespaces(_pContext->tok, nospace);
+		int pos = 0;
+		pos = Utilities::StringHelper::FindSubStr(nospace, "version=\"");
+		if (pos != -1) {
+			pos += 9;
+			size_t i = pos;
+			while (nospace[i] != '"')
+				i++;
+			_pContext->_version.assign(nospace, pos, i - pos);
+		}
+
+		pos = Utilities::StringHelper::FindSubStr(nospace, "encoding=\"");
+		if (pos != -1) {
+			pos += 10;
+			size_t i = pos;
+			while (nospace[i] != '"')
+				i++;
+			_pContext->_encoding.assign(nospace, pos, i - pos);
+		}
+		if (_pContext->_transcoded)
+			_pContext->_encoding = "UTF-8";
+		_pContext->_pHandler->Declaration(_pContext->_version, _pContext->_encoding);
+	}
+
+	/** Function to Copy a Span to str Without Any of its Whitespaces.
+	  *
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.1
+	  *		- Writes to str (Keeps its Memory) Instead of Returning a String.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void RemoveAllWnitespaces(const Utilities::StringSpan & src, std::string & str) {
+		str.clear();
+		for (size_t i = 0; i < src.length; i++) {
+			if (std::isspace((unsigned char)src.data[i]))
+				continue;
+			str.push_back(src.data[i]);
+		}
+	}
+};
+
+/*
+ * ----------------------------------------------------------------------
+ *  Table Driven Engine
+ * ----------------------------------------------------------------------
+ * Same Tokens and Same XMLDocument as the State Classes, but the Next
+ * State Comes From a Transition Table Indexed by Character Class Instead
+ * of State::NextState's if-Chain, and the States are Called Through a
+ * switch With Qualified (Non-Virtual) Calls so They Can be Inlined.
+ */
+namespace Dfa {
+	/* Low 2 Bits : Class of the Current Character (Other, '<', '>', Space).
+	 * Next 2 Bits : Class of the Next Character (Other, '?', '/').
+	 */
+	enum CharClass : unsigned char { O = 0, L = 1, G = 2, S = 3, Q = 1 << 2, F = 2 << 2 };
+	/* Same Order as TraceEvent::State */
+	enum StateId : unsigned char { Headers, OpenTag, CloseTag, Whitespace, Value, Transition };
+
+	const unsigned char kCharClass[256] = {
+		O, O, O, O, O, O, O, O, O, S, S, S, S, S, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		S, O, O, O, O, O, O, O, O, O, O, O, O, O, O, F,
+		O, O, O, O, O, O, O, O, O, O, O, O, L, O, G, Q,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+		O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,
+	};
+
+	/* [Current Character Class][Next Character Class] -> Next State */
+	const unsigned char kTransition[4][3] = {
+		/* Other */	{ Value, Value, Value },
+		/* '<'   */	{ OpenTag, Headers, CloseTag },
+		/* '>'   */	{ Whitespace, Whitespace, Whitespace },
+		/* Space */	{ Whitespace, Whitespace, Whitespace },
+	};
+
+	/** Function to Look Up the State Following the Current Character.
+	  *
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	inline unsigned NextState(const Context * pContext) {
+		unsigned next = pContext->_pCur < pContext->_pEnd ? (kCharClass[(unsigned char)*pContext->_pCur] >> 2) : 0;
+		return kTransition[kCharClass[(unsigned char)pContext->currChar] & 3][next];
+	}
+
+	/** Function to Run One State Over the Input.
+	  *
+	  * Dependant Function(s) - EatHeaders::EatChars, EatOpenTag::EatChars,
+	  *							EatCloseTag::EatChars, EatWhitespace::EatChars,
+	  *							EatValue::EatChars
+	  *
+	  * Ver : 1.2
+	  *		- Counts the Token and (Context::_timeStates) Times the State.
+	  * Ver : 1.1
+	  *		- Traces the State and the Token it Reads (XML_TRACE).
+	  * Ver : 1.0
+	  *		- First Release (Moved Out of Dfa::Run).
+	  */
+	inline void Dispatch(Context * pContext, unsigned state) {
+		switch (state) {
+		case Headers:	 static_cast<EatHeaders *>(pContext->_pEatHeaders)->EatHeaders::EatChars(); break;
+		case OpenTag:	 static_cast<EatOpenTag *>(pContext->_pEatOpenTag)->EatOpenTag::EatChars(); break;
+		case CloseTag:	 static_cast<EatCloseTag *>(pContext->_pEatCloseTag)->EatCloseTag::EatChars(); break;
+		case Whitespace: static_cast<EatWhitespace *>(pContext->_pEatWhitespace)->EatWhitespace::EatChars(); break;
+		default:		 static_cast<EatValue *>(pContext->_pEatValue)->EatValue::EatChars(); break;
+		}
+	}
+
+	inline void Eat(Context * pContext, unsigned state) {
+		XML_TRACE_STATE(pContext, state);
+		if (pContext->_timeStates) {
+			unsigned long long start = ReadCycles();
+			Dispatch(pContext, state);
+			pContext->_stats.cycles[state] += ReadCycles() - start;
+		}
+		else
+			Dispatch(pContext, state);
+		pContext->_stats.tokens[state] += !pContext->tok.empty();
+		XML_TRACE_TOKEN(pContext);
+	}
+
+	/** Function to Run the Table Driven Engine Starting in state. Without
+	  * pStop it Runs Until the Input is Exhausted. With pStop (Which Must
+	  * Point at a '<') it Stops as Soon as That '<' Has Been Consumed and
+	  * Returns True if it Was Consumed as the End of a Token (i.e. the '<'
+	  * Really Starts a Tag) or False if a Token Ran Over it.
+	  *
+	  * Dependant Function(s) - Dfa::Eat, Dfa::NextState
+	  *
+	  * Ver : 1.1
+	  *		- Added state and pStop Parameters (Used For Chunks).
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	bool Run(Context * pContext, unsigned state = Headers, const char * pStop = nullptr) {
+		while (pContext->_good) {
+			Eat(pContext, state);
+			if (!pContext->_good)
+				break;
+			if (pStop != nullptr && pContext->_pCur > pStop)
+				return pContext->_pCur == pStop + 1;
+			state = NextState(pContext);
+		}
+		return pStop == nullptr;
+	}
+
+	/** Function to Run the Engine Over Input Which May Not Have Fully Arrived
+	  * (Toker::Feed). A State Only Reports its Token Once it Has Found the
+	  * End of it, and Otherwise Consumes the Rest of the Input Without Side
+	  * Effects, so Unless final is Set Such a State is Rolled Back and Run
+	  * Again on the Next Call. The Next State is Also Only Picked Once the
+	  * Character After the Current One Has Arrived. Context::_resume Keeps
+	  * the State to Run Next Between Calls, and Context::_scanned How Far it
+	  * Had Searched, so Running it Again Does Not Search the Whole Token
+	  * Again. A Validation Error Found on the Way (Context::_pError) Stops
+	  * the Engine For Good.
+	  *
+	  * Dependant Function(s) - Dfa::Eat, Dfa::NextState
+	  *
+	  * Ver : 1.2
+	  *		- The State Run Again Resumes its Search (Context::_scanned,
+	  *		  Context::_scannedQuote).
+	  * Ver : 1.1
+	  *		- Sets Context::_moreInput; Validation Errors are Not Rolled Back.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void Pump(Context * pContext, bool final) {
+		pContext->_moreInput = !final;
+		pContext->_pColumnAnchor = nullptr;
+		while (pContext->_good) {
+			unsigned state = pContext->_resume;
+			if (state == Transition) {
+				if (pContext->_pCur == pContext->_pEnd && !final)
+					return;
+				state = NextState(pContext);
+			}
+			const char * pCur = pContext->_pCur;
+			int prevChar = pContext->prevChar;
+			int currChar = pContext->currChar;
+			size_t lineCount = pContext->_lineCount;
+			pContext->_pScanFrom = pCur + pContext->_scanned;
+			pContext->_pScanQuote = pContext->_scannedQuote != std::string::npos ? pCur + pContext->_scannedQuote : nullptr;
+			Eat(pContext, state);
+			pContext->_scanned = pContext->_pScanFrom - pCur;
+			pContext->_scannedQuote = pContext->_pScanQuote != nullptr ? pContext->_pScanQuote - pCur : std::string::npos;
+			pContext->_pScanFrom = pContext->_pScanQuote = nullptr;
+			if (!pContext->_good && !final && (pContext->_pError == nullptr || pContext->_pError->message.empty())) {
+				/* The State Runs Again, so its Token Must Not be Counted Twice */
+				pContext->_stats.tokens[state] -= !pContext->tok.empty();
+				pContext->_pCur = pCur;
+				pContext->prevChar = prevChar;
+				pContext->currChar = currChar;
+				pContext->_lineCount = lineCount;
+				pContext->_good = true;
+				pContext->_resume = state;
+				return;
+			}
+			pContext->_scanned = 0;
+			pContext->_scannedQuote = std::string::npos;
+			pContext->_resume = Transition;
+		}
+	}
+}
+
+/*
+ * ----------------------------------------------------------------------
+ *  Chunked (Parallel) Parsing
+ * ----------------------------------------------------------------------
+ */
+
+namespace XMLScanner {
+	/** ParseHandler For One Chunk of the Input (See Toker::ComputeParallel).
+	  * Elements are Built Into Subtrees Which are Not Yet Attached to Any
+	  * Document. Everything Which Concerns Elements Opened Before the Chunk
+	  * (Where a Top Level Subtree Goes, Text and Close Tags Outside the
+	  * Chunk's Own Elements) is Recorded in Order, and Stitch Replays it on
+	  * the DocumentBuilder's Scope Stack. The Nodes are Made in the Chunk's
+	  * Own NodeArena, Which the Document Takes Over on Stitch.
+	  *
+	  * Dependant Class(es) or Structure(s) - ParseHandler, DocumentBuilder, Node,
+	  *										  NodeArena
+	  *
+	  * Ver : 1.1
+	  *		- Nodes Come From _arena.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class ChunkBuilder : public ParseHandler {
+	public:
+		ChunkBuilder() : isCorrupt(false), hasDeclaration(false) {}
+		ChunkBuilder(const ChunkBuilder&) = delete;
+		ChunkBuilder& operator=(const ChunkBuilder&) = delete;
+
+		virtual void Declaration(const std::string & version, const std::string & encoding);
+		virtual void StartElement(const Utilities::StringSpan & tag);
+		virtual void Attribute(const Utilities::StringSpan & name, const Utilities::StringSpan & value);
+		virtual void Text(const Utilities::StringSpan & value);
+		virtual void EndElement(const Utilities::StringSpan & tag);
+
+		void Stitch(DocumentBuilder & builder);
+	private:
+		enum OpKind { Adopt, SetText, Close };
+		struct Op {
+			OpKind kind;
+			Node * node;
+			std::string text;
+		};
+		std::vector<Op> _ops;
+		std::vector<Node *> _scope;
+		NodeArena _arena;
+		bool isCorrupt;
+		bool hasDeclaration;
+		std::string _version;
+		std::string _encoding;
+	};
+}
+
+namespace {
+	/* Smallest Chunk Worth a Thread When Toker::ComputeParallel Picks the Count */
+	const size_t kMinChunkBytes = 1 << 20;
+
+	/* One Chunk of the Input : [pBegin, pStop) Where *pStop is the '<' the Next Chunk Starts at.
+	 * pInvalid is the First Byte in the Chunk Which is Not Valid UTF-8 (nullptr if None).
+	 */
+	struct ChunkJob {
+		const char * pBegin;
+		const char * pStop;
+		const char * pInvalid;
+		ChunkBuilder builder;
+		size_t lineCount;
+		bool clean;
+		ParseStats stats;
+		long depth;
+		long maxDepth;
+	};
+
+	/** Function to Delete a Subtree Which Was Never Attached to a Document.
+	  *
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void DeleteSubtree(Node * pNode) {
+		for (Node * pChild : pNode->children)
+			DeleteSubtree(pChild);
+		delete pNode;
+	}
+
+	/** Function to Split [pBegin, pEnd) Into At Most count Chunks of About the
+	  * Same Size. Every Chunk But the First Starts at a '<'. Returns the Chunk
+	  * Starts Followed by pEnd.
+	  *
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	std::vector<const char *> SplitChunks(const char * pBegin, const char * pEnd, size_t count) {
+		std::vector<const char *> cuts(1, pBegin);
+		size_t size = pEnd - pBegin;
+		for (size_t i = 1; i < count; i++) {
+			const char * p = std::max(pBegin + size / count * i, cuts.back() + 1);
+			if (p >= pEnd)
+				break;
+			const char * pCut = (const char *)memchr(p, '<', pEnd - p);
+			if (pCut == nullptr)
+				break;
+			cuts.push_back(pCut);
+		}
+		cuts.push_back(pEnd);
+		return cuts;
+	}
+
+	/** Function to Run the Table Driven Engine Over One Chunk With its Own
+	  * Context. The First Chunk Starts in EatHeaders Like a Whole File; the
+	  * Others Start as if Their '<' Had Just Been Read. job.clean is False
+	  * if a Token Ran Over the End of the Chunk. The Chunk's Statistics are
+	  * Kept in job (Depths Relative to the Start of the Chunk). With checkUtf8
+	  * the Chunk is First Validated as UTF-8, and Not Parsed if it is Not
+	  * (job.pInvalid). A Chunk Starts at a '<', so No Character Crosses Into
+	  * the Next One.
+	  *
+	  * Dependant Function(s) - ScanKernels::FindInvalidUtf8, State::Attach,
+	  *							Dfa::NextState, Dfa::Run
+	  *
+	  * Ver : 1.2
+	  *		- Validates the Chunk's UTF-8 (checkUtf8).
+	  * Ver : 1.1
+	  *		- Keeps the Chunk's Statistics.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void ParseChunk(ChunkJob * job, const char * pFirst, const char * pEnd, bool MagicQuotes, bool timeStates, bool checkUtf8) {
+		Context context;
+		job->pInvalid = nullptr;
+		if (checkUtf8) {
+			const char * pInvalid = context._pScan->FindInvalidUtf8(job->pBegin, job->pStop);
+			if (pInvalid != job->pStop) {
+				job->pInvalid = pInvalid;
+				return;
+			}
+		}
+		context.VERBOSE = false;
+		context.MagicQuotes = MagicQuotes;
+		context._timeStates = timeStates;
+		context._pHandler = &job->builder;
+		context._pState->Attach(job->pBegin, pEnd);
+		unsigned state = Dfa::Headers;
+		if (job->pBegin != pFirst) {
+			context.prevChar = (unsigned char)job->pBegin[-1];
+			context.currChar = '<';
+			context._pCur = job->pBegin + 1;
+			state = Dfa::NextState(&context);
+		}
+		job->clean = Dfa::Run(&context, state, job->pStop == pEnd ? nullptr : job->pStop);
+		job->lineCount = context._lineCount;
+		job->stats = context._stats;
+		job->depth = context._depth;
+		job->maxDepth = context._maxDepth;
+	}
+}
+
+/** Default Constructor For Context Structure. This Function
+  * will Initialize All the States, Default Headers and MagicQuotes
+  * Protection Enable/Disable (the Markers are in the Shared
+  * MagicQuoteDecoder).
+  *
+  * Dependant Function(s) - MagicQuoteDecoder::Standard
+  *
+  * Ver : 3.4
+  *		- MagicQuotesR Moved to MagicQuoteDecoder.
+  * Ver : 3.3
+  *		- Per Parse State is Initialized by Reset.
+  * Ver : 3.2
+  *		- Initializes the Projection State.
+  * Ver : 3.1
+  *		- Initializes the Validation State.
+  * Ver : 3.0
+  *		- Initializes the Parse Statistics State.
+  * Ver : 2.8
+  *		- Added the Standard XML Entities to MagicQuotesR and Indexes it.
+  * Ver : 2.4
+  *		- No Longer Creates the XML Document or the Scope (See DocumentBuilder).
+  * Ver : 1.0
+  *		- First Release.
+  */
+Context::Context() {
+	_pEatValue = new EatValue(this);
+	_pEatHeaders = new EatHeaders(this);
+	_pEatOpenTag = new EatOpenTag(this);
+	_pEatCloseTag = new EatCloseTag(this);
+	_pEatWhitespace = new EatWhitespace(this);
+	_pScan = &ScanKernels::Select();
+	_lazyValues = false;
+	_timeStates = false;
+	_deferUtf8Check = false;
+	_pProjection = nullptr;
+	Reset();
+
+	MagicQuotes = false;
+	_pMagicQuotes = &MagicQuoteDecoder::Standard();
+}
+
+/** Default Constructor For MagicQuoteDecoder Structure. Fills MagicQuotesR
+  * and Indexes it.
+  *
+  * Dependant Function(s) - MagicQuoteDecoder::IndexMagicQuotes
+  *
+  * Ver : 1.0
+  *		- First Release (Moved Out of the Context Constructor).
+  */
+MagicQuoteDecoder::MagicQuoteDecoder() {
+	/* XML Protection Mechanism While Reading From Disk */
+	MagicQuotesR.insert(std::make_pair(";opBracket", "<"));
+	MagicQuotesR.insert(std::make_pair(";clBracket", ">"));
+	MagicQuotesR.insert(std::make_pair(";dbQuotes", "\""));
+	MagicQuotesR.insert(std::make_pair(";bkSlash", "/"));
+	MagicQuotesR.insert(std::make_pair(";nlWhiteSpace", "\n"));
+	MagicQuotesR.insert(std::make_pair(";tbWhiteSpace", "\t"));
+	MagicQuotesR.insert(std::make_pair(";eqSymbol", "\t"));
+
+	/* Standard XML Entities */
+	MagicQuotesR.insert(std::make_pair("&lt;", "<"));
+	MagicQuotesR.insert(std::make_pair("&gt;", ">"));
+	MagicQuotesR.insert(std::make_pair("&amp;", "&"));
+	MagicQuotesR.insert(std::make_pair("&quot;", "\""));
+	MagicQuotesR.insert(std::make_pair("&apos;", "'"));
+	IndexMagicQuotes();
+}
+
+/** Function to Get the MagicQuoteDecoder Shared by Every Context. Built
+  * on First Use.
+  *
+  * Dependant Function(s) - MagicQuoteDecoder::MagicQuoteDecoder
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+const MagicQuoteDecoder & MagicQuoteDecoder::Standard() {
+	static const MagicQuoteDecoder decoder;
+	return decoder;
+}
+
+/** Function to Put Back the Per Parse State (Input Range, Line Count,
+  * Handler, Statistics, Validation & Projection State, Headers) as it is
+  * Before the First Parse. Settings (MagicQuotes, _lazyValues,
+  * _timeStates), the States and the Lookup Tables are Kept, and So is the
+  * Memory of the Strings and Vectors Which are Cleared.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release (Moved Out of the Constructor).
+  */
+void Context::Reset() {
+	_pState = _pEatWhitespace;
+	_lineCount = 0;
+	prevChar = currChar = EOF;
+	_pBegin = _pCur = _pEnd = nullptr;
+	_good = false;
+	tok = Utilities::StringSpan();
+	token.clear();
+	_inputEncoding = Undecided;
+	_transcoded = false;
+	_utf8Buffer.clear();
+	_pendingInput.clear();
+	_columnBase = 0;
+
+	_pHandler = nullptr;
+	_resume = 0;
+	_scanned = 0;
+	_scannedQuote = std::string::npos;
+	_pScanFrom = _pScanQuote = nullptr;
+	_stats = ParseStats();
+	_depth = _maxDepth = 0;
+	_pError = nullptr;
+	_openTags.clear();
+	_attributeSpans.clear();
+	_sawElement = false;
+	_moreInput = false;
+	_fedTags.clear();
+	_pColumnAnchor = nullptr;
+	_anchorColumn = 0;
+	_projectionDepth = _matchDepth = 0;
+	_version = "1.0";
+	_encoding = "UTF-8";
+}
+
+/** Default Destructor For Context Structure. This Function
+  * will Delete All the Created States.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+Context::~Context() {
+	delete _pEatValue;
+	delete _pEatHeaders;
+	delete _pEatOpenTag;
+	delete _pEatCloseTag;
+	delete _pEatWhitespace;
+}
+
+/** Default Constructor For State Class. It Does Nothing.
+  * 
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+State::State() {};
+
+
+/** Default Destructor For State Class. It Does Nothing.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+State::~State() {};
+
+
+namespace {
+	/** RawSource of an XMLDocument Built With Lazy Values. Holds the Input
+	  * (Unless the Caller Keeps it, See Toker::Compute(data, length)) and
+	  * Decodes Magic Quotes the Same Way the Toker Would Have.
+	  *
+	  * Dependant Class(es) or Structure(s) - RawSource, MagicQuoteDecoder, MappedFile
+	  *
+	  * Ver : 1.1
+	  *		- Decodes Through the Shared MagicQuoteDecoder (Was a Whole Context).
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class LazySource : public RawSource {
+	public:
+		LazySource(bool MagicQuotes) : _magicQuotes(MagicQuotes) {}
+
+		/* Memory Maps (or Reads) the File; the Text Stays Valid as Long as the LazySource */
+		bool Load(const std::string & fileSpec) {
+			if (_map.Open(fileSpec))
+				return true;
+			std::ifstream inFile(fileSpec, std::ios::binary);
+			if (!inFile.good())
+				return false;
+			_buffer.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+			return true;
+		}
+		const char * Data() const { return _map.IsOpen() ? _map.Data() : _buffer.data(); }
+		size_t Size() const { return _map.IsOpen() ? _map.Size() : _buffer.size(); }
+
+		virtual void Decode(const char * data, size_t length, std::string & out) const {
+			out.assign(data, length);
+			if (_magicQuotes)
+				MagicQuoteDecoder::Standard().XMLProtectionMagicQuotes(out);
+		}
+	private:
+		bool _magicQuotes;
+		Utilities::MappedFile _map;
+		std::string _buffer;
+	};
+}
+
+/** Constructor For DocumentBuilder Class. Creates the XMLDocument the
+  * Events Will be Added to and Puts its Root on the Scope Stack.
+  *
+  * Dependant Function(s) - XMLDocument::XMLDocument
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+DocumentBuilder::DocumentBuilder(bool verbose) {
+	VERBOSE = verbose;
+	isCorrupt = false;
+	_tagIndex = false;
+	_pSource = nullptr;
+	_pRawBegin = _pRawEnd = nullptr;
+	xDoc = new XMLDocument(verbose);
+	_scope.push(xDoc->getRoot());
+}
+
+/** Default Destructor For DocumentBuilder Class. Deletes the XMLDocument
+  * Unless it Has Been Handed Over With Release.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+DocumentBuilder::~DocumentBuilder() {
+	delete xDoc;
+}
+
+/** Function to Hand Over the Built XMLDocument to the Caller (Who Then
+  * Owns it). Returns nullptr if it Was Already Released.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+XMLDocument * DocumentBuilder::Release() {
+	XMLDocument * result = xDoc;
+	xDoc = nullptr;
+	while (!_scope.empty())
+		_scope.pop();
+	return result;
+}
+
+/** Function to Start Building a New XMLDocument, Just Like a Newly
+  * Constructed DocumentBuilder (But Keeping SetTagIndex). An XMLDocument
+  * Which Was Not Released is Deleted. The Scope Stack Keeps its Memory.
+  *
+  * Dependant Function(s) - XMLDocument::XMLDocument,
+  *							XMLDocument::BuildTagIndex
+  *
+  * Ver : 1.1
+  *		- The New XMLDocument Gets the Tag Index if SetTagIndex Asked For it.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void DocumentBuilder::Reset() {
+	delete xDoc;
+	while (!_scope.empty())
+		_scope.pop();
+	isCorrupt = false;
+	_pSource = nullptr;
+	_pRawBegin = _pRawEnd = nullptr;
+	xDoc = new XMLDocument(VERBOSE);
+	if (_tagIndex)
+		xDoc->BuildTagIndex();
+	_scope.push(xDoc->getRoot());
+}
+
+/** Function to Choose Whether the XMLDocument Being Built (and Those After
+  * a Reset) Has the Tag Index. The Index is Built While the Document is
+  * Still Empty, so Every Node is Indexed as it is Added.
+  *
+  * Dependant Function(s) - XMLDocument::BuildTagIndex, XMLDocument::SetTagIndex
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void DocumentBuilder::SetTagIndex(bool indexed) {
+	_tagIndex = indexed;
+	if (xDoc == nullptr)
+		return;
+	if (indexed)
+		xDoc->BuildTagIndex();
+	else
+		xDoc->SetTagIndex(false);
+}
+
+/** Function to Build With Lazy Values : Text and Attribute Values are
+  * Reported Undecoded, and Those Which Lie in [pBegin, pEnd) are Kept as
+  * Spans (Decoded by source on First Read). Others are Decoded Right Away.
+  * The XMLDocument Takes Over source.
+  *
+  * Dependant Function(s) - XMLDocument::setRawSource
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void DocumentBuilder::SetRawSource(RawSource * source, const char * pBegin, const char * pEnd) {
+	_pSource = source;
+	_pRawBegin = pBegin;
+	_pRawEnd = pEnd;
+	if (xDoc != nullptr)
+		xDoc->setRawSource(source);
+}
+
+/** Function to Set XML Header Attributes (Version & Encoding).
+  *
+  * Dependant Function(s) - XMLDocument::setVersion, XMLDocument::setEncoding
+  *
+  * Ver : 1.0
+  *		- First Release (Moved From EatHeaders::SetHeaders).
+  */
+void DocumentBuilder::Declaration(const std::string & version, const std::string & encoding) {
+	std::string ver = version, enc = encoding;
+	xDoc->setVersion(ver);
+	xDoc->setEncoding(enc);
+}
+
+/** Function to Create a Node For an Open Tag, Add it Under the Innermost
+  * Open Element and Push it onto the Scope Stack.
+  *
+  * Dependant Function(s) - XMLDocument::CreateNode, XMLDocument::AppendChild
+  *
+  * Ver : 1.2
+  *		- The Node Comes From the Document's NodeArena.
+  * Ver : 1.1
+  *		- Scope Push is Traced (XML_TRACE) Instead of VERBOSE Output.
+  * Ver : 1.0
+  *		- First Release (Moved From EatOpenTag::EatChars).
+  */
+void DocumentBuilder::StartElement(const Utilities::StringSpan & tag) {
+	Node * newNode = xDoc->CreateNode();
+	newNode->tag.assign(tag.data, tag.length);
+	if (_scope.empty())
+		xDoc->AppendChild(newNode, nullptr);
+	else
+		xDoc->AppendChild(newNode, _scope.top());
+	_scope.push(newNode);
+	XML_TRACE_SCOPE(TraceEvent::PushScope, _scope.size());
+}
+
+/** Function to Add an Attribute to the Node Created by the Last StartElement.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.2
+  *		- With Lazy Values the Value is Kept as a Span (See SetRawSource).
+  * Ver : 1.1
+  *		- Builds the Attribute Strings In Place (emplace_back).
+  * Ver : 1.0
+  *		- First Release (Moved From EatOpenTag::SetNodeInfo).
+  */
+void DocumentBuilder::Attribute(const Utilities::StringSpan & name, const Utilities::StringSpan & value) {
+	if (_scope.empty())
+		return;
+	Node * pNode = _scope.top();
+	if (_pSource == nullptr) {
+		pNode->attributes.emplace_back(std::piecewise_construct,
+			std::forward_as_tuple(name.data, name.length), std::forward_as_tuple(value.data, value.length));
+		return;
+	}
+	pNode->source = _pSource;
+	pNode->attributes.emplace_back(std::piecewise_construct, std::forward_as_tuple(name.data, name.length), std::forward_as_tuple());
+	if (value.data >= _pRawBegin && value.end() <= _pRawEnd) {
+		pNode->rawAttributes.resize(pNode->attributes.size() - 1, std::make_pair((const char *)nullptr, (size_t)0));
+		pNode->rawAttributes.push_back(std::make_pair(value.data, value.length));
+	}
+	else
+		_pSource->Decode(value.data, value.length, pNode->attributes.back().second);
+}
+
+/** Function to Set the Value of the Innermost Open Element.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.1
+  *		- With Lazy Values the Value is Kept as a Span (See SetRawSource).
+  * Ver : 1.0
+  *		- First Release (Moved From EatValue::EatChars).
+  */
+void DocumentBuilder::Text(const Utilities::StringSpan & value) {
+	if (_scope.empty())
+		return;
+	Node * pNode = _scope.top();
+	if (_pSource == nullptr) {
+		pNode->value.assign(value.data, value.length);
+		return;
+	}
+	pNode->source = _pSource;
+	if (value.data >= _pRawBegin && value.end() <= _pRawEnd) {
+		pNode->rawValue = value.data;
+		pNode->rawValueLength = value.length;
+	}
+	else {
+		pNode->rawValue = nullptr;
+		_pSource->Decode(value.data, value.length, pNode->value);
+	}
+}
+
+/** Function to Close the Innermost Open Element. A Close Tag Which Does
+  * Not Match it Marks the Document as Corrupt.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.1
+  *		- Scope Pop is Traced (XML_TRACE) Instead of VERBOSE Output.
+  * Ver : 1.0
+  *		- First Release (Moved From EatCloseTag::EatChars).
+  */
+void DocumentBuilder::EndElement(const Utilities::StringSpan & tag) {
+	if (_scope.empty() || tag != _scope.top()->tag)
+		isCorrupt = true;
+	if (_scope.empty())
+		return;
+	_scope.pop();
+	XML_TRACE_SCOPE(TraceEvent::PopScope, _scope.size());
+}
+
+/** Constructor For FlatBuilder Class. Starts an Empty FlatDocument Which
+  * Interns its Names in symbols (a Table of its Own When it is Null).
+  *
+  * Dependant Function(s) - FlatDocument::FlatDocument
+  *
+  * Ver : 1.1
+  *		- Takes the SymbolTable to Share.
+  * Ver : 1.0
+  *		- First Release.
+  */
+FlatBuilder::FlatBuilder(std::shared_ptr<SymbolTable> symbols) : _symbols(symbols) {
+	isCorrupt = false;
+	flatDoc = new FlatDocument(_symbols);
+}
+
+/** Default Destructor For FlatBuilder Class. Deletes the FlatDocument
+  * Unless it Has Been Handed Over With Release.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+FlatBuilder::~FlatBuilder() {
+	delete flatDoc;
+}
+
+/** Function to Hand Over the Built FlatDocument to the Caller (Who Then
+  * Owns it). Returns nullptr if it Was Already Released.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+FlatDocument * FlatBuilder::Release() {
+	FlatDocument * result = flatDoc;
+	flatDoc = nullptr;
+	return result;
+}
+
+/** Function to Start Building a New FlatDocument. A FlatDocument Which Was
+  * Not Released is Emptied and Reused (Keeping its Memory and SymbolTable).
+  *
+  * Dependant Function(s) - FlatDocument::Clear
+  *
+  * Ver : 1.1
+  *		- A New FlatDocument Shares the Builder's SymbolTable.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void FlatBuilder::Reset() {
+	isCorrupt = false;
+	if (flatDoc == nullptr)
+		flatDoc = new FlatDocument(_symbols);
+	else {
+		flatDoc->setVersion("1.0");
+		flatDoc->setEncoding("UTF-8");
+		flatDoc->Clear();
+	}
+}
+
+/** Function to Set XML Header Attributes (Version & Encoding).
+  *
+  * Dependant Function(s) - FlatDocument::setVersion, FlatDocument::setEncoding
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void FlatBuilder::Declaration(const std::string & version, const std::string & encoding) {
+	flatDoc->setVersion(version);
+	flatDoc->setEncoding(encoding);
+}
+
+/** Function to Open a Node For an Open Tag Under the Innermost Open
+  * Element.
+  *
+  * Dependant Function(s) - FlatDocument::OpenNode
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void FlatBuilder::StartElement(const Utilities::StringSpan & tag) {
+	flatDoc->OpenNode(tag);
+}
+
+/** Function to Add an Attribute to the Node Opened by the Last StartElement.
+  *
+  * Dependant Function(s) - FlatDocument::AddAttribute
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void FlatBuilder::Attribute(const Utilities::StringSpan & name, const Utilities::StringSpan & value) {
+	if (flatDoc->getOpenNode().Index() != 0)
+		flatDoc->AddAttribute(name, value);
+}
+
+/** Function to Set the Value of the Innermost Open Element.
+  *
+  * Dependant Function(s) - FlatDocument::SetValue
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void FlatBuilder::Text(const Utilities::StringSpan & value) {
+	if (flatDoc->getOpenNode().Index() != 0)
+		flatDoc->SetValue(value);
+}
+
+/** Function to Close the Innermost Open Element. A Close Tag Which Does
+  * Not Match it Marks the Document as Corrupt.
+  *
+  * Dependant Function(s) - FlatDocument::CloseNode
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void FlatBuilder::EndElement(const Utilities::StringSpan & tag) {
+	Utilities::StringSpan open = flatDoc->getOpenNode().Tag();
+	if (open.length != tag.length || std::memcmp(open.data, tag.data, tag.length) != 0)
+		isCorrupt = true;
+	if (!flatDoc->CloseNode())
+		isCorrupt = true;
+}
+
+/** Function to Keep the XML Header Attributes Until Stitch.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void ChunkBuilder::Declaration(const std::string & version, const std::string & encoding) {
+	hasDeclaration = true;
+	_version = version;
+	_encoding = encoding;
+}
+
+/** Function to Create a Node For an Open Tag. Added Under the Innermost
+  * Open Element of the Chunk, or Recorded as a Top Level Subtree.
+  *
+  * Dependant Function(s) - NodeArena::New
+  *
+  * Ver : 1.1
+  *		- The Node Comes From the Chunk's NodeArena.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void ChunkBuilder::StartElement(const Utilities::StringSpan & tag) {
+	Node * newNode = _arena.New();
+	newNode->tag.assign(tag.data, tag.length);
+	if (_scope.empty())
+		_ops.push_back({ Adopt, newNode, std::string() });
+	else
+		_scope.back()->children.push_back(newNode);
+	_scope.push_back(newNode);
+}
+
+/** Function to Add an Attribute to the Node Created by the Last StartElement.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void ChunkBuilder::Attribute(const Utilities::StringSpan & name, const Utilities::StringSpan & value) {
+	if (_scope.empty())
+		return;
+	_scope.back()->attributes.emplace_back(std::piecewise_construct,
+		std::forward_as_tuple(name.data, name.length), std::forward_as_tuple(value.data, value.length));
+}
+
+/** Function to Set the Value of the Innermost Open Element (Recorded if
+  * That Element Was Opened Before the Chunk).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void ChunkBuilder::Text(const Utilities::StringSpan & value) {
+	if (_scope.empty())
+		_ops.push_back({ SetText, nullptr, value.str() });
+	else
+		_scope.back()->value.assign(value.data, value.length);
+}
+
+/** Function to Close the Innermost Open Element of the Chunk (Recorded if
+  * That Element Was Opened Before the Chunk).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void ChunkBuilder::EndElement(const Utilities::StringSpan & tag) {
+	if (_scope.empty()) {
+		_ops.push_back({ Close, nullptr, tag.str() });
+		return;
+	}
+	if (tag != _scope.back()->tag)
+		isCorrupt = true;
+	_scope.pop_back();
+}
+
+/** Function to Add What the Chunk Built to builder, Exactly as if builder
+  * Had Received the Chunk's Events Itself. Elements Still Open at the End
+  * of the Chunk are Pushed on builder's Scope Stack. The Subtrees (and the
+  * Chunk's NodeArena) are Then Owned by builder's XMLDocument.
+  *
+  * Dependant Function(s) - XMLDocument::AdoptNodes, XMLDocument::AppendChild,
+  *							DocumentBuilder::Declaration, DocumentBuilder::Text,
+  *							DocumentBuilder::EndElement
+  *
+  * Ver : 1.1
+  *		- Hands the Chunk's NodeArena to the Document.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void ChunkBuilder::Stitch(DocumentBuilder & builder) {
+	builder.xDoc->AdoptNodes(_arena);
+	if (hasDeclaration)
+		builder.Declaration(_version, _encoding);
+	for (Op & op : _ops) {
+		switch (op.kind) {
+		case Adopt:
+			builder.xDoc->AppendChild(op.node, builder._scope.empty() ? nullptr : builder._scope.top());
+			break;
+		case SetText:
+			builder.Text(op.text);
+			break;
+		case Close:
+			builder.EndElement(op.text);
+			break;
+		}
+	}
+	for (Node * pNode : _scope)
+		builder._scope.push(pNode);
+	if (isCorrupt)
+		builder.isCorrupt = true;
+	_ops.clear();
+	_scope.clear();
+}
+
+/*
+ * ----------------------------------------------------------------------
+ *  Compressed Input
+ * ----------------------------------------------------------------------
+ * Files are Read Through a BlockReader, Which Hands Out the (Decompressed)
+ * Text a Bounded Block at a Time so it Can be Fed to the Toker Without
+ * Ever Holding the Whole Text.
+ */
+namespace {
+	enum Compression { Uncompressed, Gzip, Zstd };
+
+	/* Compressed Bytes Read From the File at Once */
+	const size_t kCompressedBlockBytes = 64 << 10;
+
+	/** Function to Tell the Compression of the Input From its First Bytes
+	  * (gzip : 1F 8B, zstd : 28 B5 2F FD).
+	  *
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	Compression DetectCompression(const char * pBegin, const char * pEnd) {
+		const unsigned char * p = (const unsigned char *)pBegin;
+		if (pEnd - pBegin >= 2 && p[0] == 0x1F && p[1] == 0x8B)
+			return Gzip;
+		if (pEnd - pBegin >= 4 && p[0] == 0x28 && p[1] == 0xB5 && p[2] == 0x2F && p[3] == 0xFD)
+			return Zstd;
+		return Uncompressed;
+	}
+
+	/** Input File Read Block by Block. Read Fills At Most capacity Bytes of
+	  * Text and Returns How Many (0 Once the Input is Exhausted). Failed is
+	  * Set if the Compressed Data Turned Out to be Corrupt.
+	  *
+	  * Dependant Class(es) or Structure(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class BlockReader {
+	public:
+		BlockReader(const std::string & fileSpec) : _file(fileSpec, std::ios::binary), _failed(false), _done(false) {}
+		BlockReader(const BlockReader&) = delete;
+		BlockReader& operator=(const BlockReader&) = delete;
+		virtual ~BlockReader() {}
+		virtual size_t Read(char * pOut, size_t capacity) {
+			_file.read(pOut, capacity);
+			return (size_t)_file.gcount();
+		}
+		bool Failed() const { return _failed; }
+	protected:
+		std::ifstream _file;
+		bool _failed;
+		bool _done;
+	};
+
+#ifdef XML_WITH_ZLIB
+	/** BlockReader Which Inflates a gzip File (Also Several gzip Members
+	  * Written One After the Other, Like pigz or cat Produce). A File Which
+	  * Ends Inside a Member is Reported as Failed.
+	  *
+	  * Dependant Class(es) or Structure(s) - BlockReader
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class GzipReader : public BlockReader {
+	public:
+		GzipReader(const std::string & fileSpec) : BlockReader(fileSpec), _in(kCompressedBlockBytes), _inMember(false) {
+			std::memset(&_stream, 0, sizeof(_stream));
+			/* 16 : gzip Header and Trailer */
+			_failed = inflateInit2(&_stream, 16 + MAX_WBITS) != Z_OK;
+			_done = _failed;
+		}
+		~GzipReader() { inflateEnd(&_stream); }
+
+		virtual size_t Read(char * pOut, size_t capacity) {
+			_stream.next_out = (Bytef *)pOut;
+			_stream.avail_out = (uInt)capacity;
+			while (_stream.avail_out > 0 && !_done) {
+				if (_stream.avail_in == 0) {
+					_file.read(_in.data(), _in.size());
+					_stream.next_in = (Bytef *)_in.data();
+					_stream.avail_in = (uInt)_file.gcount();
+					if (_stream.avail_in == 0) {
+						_failed = _inMember;
+						_done = true;
+						break;
+					}
+				}
+				_inMember = true;
+				int result = inflate(&_stream, Z_NO_FLUSH);
+				if (result == Z_STREAM_END) {
+					_inMember = false;
+					_done = inflateReset(&_stream) != Z_OK;
+				}
+				else if (result != Z_OK && result != Z_BUF_ERROR)
+					_failed = _done = true;
+			}
+			return capacity - _stream.avail_out;
+		}
+	private:
+		std::vector<char> _in;
+		z_stream _stream;
+		bool _inMember;
+	};
+#endif
+
+#ifdef XML_WITH_ZSTD
+	/** BlockReader Which Decompresses a zstd File (Any Number of Frames).
+	  * A File Which Ends Inside a Frame is Reported as Failed.
+	  *
+	  * Dependant Class(es) or Structure(s) - BlockReader
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class ZstdReader : public BlockReader {
+	public:
+		ZstdReader(const std::string & fileSpec) : BlockReader(fileSpec), _in(kCompressedBlockBytes), _pending(0) {
+			_pStream = ZSTD_createDStream();
+			_input.src = _in.data();
+			_input.size = _input.pos = 0;
+			_failed = _done = _pStream == nullptr || ZSTD_isError(ZSTD_initDStream(_pStream));
+		}
+		~ZstdReader() { ZSTD_freeDStream(_pStream); }
+
+		virtual size_t Read(char * pOut, size_t capacity) {
+			ZSTD_outBuffer output = { pOut, capacity, 0 };
+			while (output.pos < output.size && !_done) {
+				if (_input.pos == _input.size) {
+					_file.read(_in.data(), _in.size());
+					_input.size = (size_t)_file.gcount();
+					_input.pos = 0;
+					if (_input.size == 0) {
+						_failed = _pending != 0;
+						_done = true;
+						break;
+					}
+				}
+				/* 0 Once a Frame is Complete */
+				_pending = ZSTD_decompressStream(_pStream, &output, &_input);
+				if (ZSTD_isError(_pending))
+					_failed = _done = true;
+			}
+			return output.pos;
+		}
+	private:
+		std::vector<char> _in;
+		ZSTD_DStream * _pStream;
+		ZSTD_inBuffer _input;
+		size_t _pending;
+	};
+#endif
+
+	/** Function to Open a File For Reading Block by Block, Decompressing it
+	  * if its Magic Bytes Say it is Compressed. Returns nullptr (and Says
+	  * Why, Also in error) if it Cannot be Opened or This Build Cannot
+	  * Decompress it.
+	  *
+	  * Dependant Function(s) - DetectCompression
+	  *
+	  * Ver : 1.1
+	  *		- Reason For a Failure is Also Returned in error.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	BlockReader * OpenBlockReader(const std::string & fileSpec, std::string & error) {
+		char magic[4];
+		std::ifstream inFile(fileSpec, std::ios::binary);
+		if (!inFile.good()) {
+			std::cout << "\n  can't open " << fileSpec << "\n\n ";
+			error = "Can't Open " + fileSpec;
+			return nullptr;
+		}
+		inFile.read(magic, sizeof(magic));
+		switch (DetectCompression(magic, magic + inFile.gcount())) {
+#ifdef XML_WITH_ZLIB
+		case Gzip: return new GzipReader(fileSpec);
+#else
+		case Gzip:
+			std::cout << "\n  can't read " << fileSpec << " : gzip Input Needs a Build With XML_WITH_ZLIB\n\n ";
+			error = "gzip Input Needs a Build With XML_WITH_ZLIB";
+			return nullptr;
+#endif
+#ifdef XML_WITH_ZSTD
+		case Zstd: return new ZstdReader(fileSpec);
+#else
+		case Zstd:
+			std::cout << "\n  can't read " << fileSpec << " : zstd Input Needs a Build With XML_WITH_ZSTD\n\n ";
+			error = "zstd Input Needs a Build With XML_WITH_ZSTD";
+			return nullptr;
+#endif
+		default: return new BlockReader(fileSpec);
+		}
+	}
+}
+
+/*
+ * ----------------------------------------------------------------------
+ *  Input Encoding
+ * ----------------------------------------------------------------------
+ * The States Scan UTF-8. The Encoding of the Input is Told by its Byte
+ * Order Mark, the Way "<?" is Written (UTF-16 Without a Mark), or Else the
+ * encoding of the XML Declaration (UTF-8 if There is None). UTF-8 Input is
+ * Validated In Place (ScanKernels::FindInvalidUtf8); Latin-1, Windows-1252
+ * and UTF-16 Input is Transcoded to UTF-8 First.
+ */
+namespace {
+	/* Bytes Looked at For the XML Declaration Before Giving Up (Toker::Feed) */
+	const size_t kMaxDeclarationBytes = 1024;
+
+	/* Windows-1252 Characters 0x80 - 0x9F (Unassigned Ones Kept as C1 Controls) */
+	const unsigned short kWindows1252[32] = {
+		0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+		0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+		0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+		0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178
+	};
+
+	/** Function to Tell Which Encoding an encoding Name Stands For (Case
+	  * Does Not Matter). A UTF-16 Name Found in Text Which Reads as ASCII
+	  * Does Not Match the Text, Which is Taken as UTF-8.
+	  *
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	InputEncoding EncodingNamed(const Utilities::StringSpan & name) {
+		static const struct { const char * name; InputEncoding encoding; } names[] = {
+			{ "utf-8", Utf8 }, { "utf8", Utf8 }, { "us-ascii", Utf8 }, { "ascii", Utf8 },
+			{ "utf-16", Utf8 }, { "utf-16le", Utf8 }, { "utf-16be", Utf8 },
+			{ "iso-8859-1", Latin1 }, { "iso8859-1", Latin1 }, { "iso_8859-1", Latin1 },
+			{ "latin1", Latin1 }, { "latin-1", Latin1 }, { "l1", Latin1 },
+			{ "windows-1252", Windows1252 }, { "cp1252", Windows1252 }
+		};
+		for (const auto & entry : names) {
+			size_t length = std::strlen(entry.name);
+			if (length != name.length)
+				continue;
+			size_t i = 0;
+			while (i < length && std::tolower((unsigned char)name.data[i]) == entry.name[i])
+				i++;
+			if (i == length)
+				return entry.encoding;
+		}
+		return Unsupported;
+	}
+
+	/** Function to Tell the Encoding of the Input From its First Bytes (See
+	  * Above). bomLength is Set to the Length of the Byte Order Mark (Which
+	  * is Not Part of the Text) and declared to the encoding of the XML
+	  * Declaration (Empty if it Was Not Looked At).
+	  *
+	  * Dependant Function(s) - EncodingNamed, FindText
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	InputEncoding DetectEncoding(const char * pBegin, const char * pEnd, size_t & bomLength, Utilities::StringSpan & declared) {
+		const unsigned char * u = (const unsigned char *)pBegin;
+		size_t length = pEnd - pBegin;
+		bomLength = 0;
+		declared = Utilities::StringSpan();
+		if (length >= 3 && u[0] == 0xEF && u[1] == 0xBB && u[2] == 0xBF) {
+			bomLength = 3;
+			return Utf8;
+		}
+		if (length >= 2 && u[0] == 0xFF && u[1] == 0xFE) {
+			bomLength = 2;
+			return Utf16LE;
+		}
+		if (length >= 2 && u[0] == 0xFE && u[1] == 0xFF) {
+			bomLength = 2;
+			return Utf16BE;
+		}
+		if (length >= 4 && u[0] == '<' && u[1] == 0 && u[2] == '?' && u[3] == 0)
+			return Utf16LE;
+		if (length >= 4 && u[0] == 0 && u[1] == '<' && u[2] == 0 && u[3] == '?')
+			return Utf16BE;
+		if (length < 5 || std::memcmp(pBegin, "<?xml", 5) != 0)
+			return Utf8;
+
+		const char * pClose = (const char *)std::memchr(pBegin, '>', length);
+		if (pClose == nullptr)
+			pClose = pEnd;
+		const char * p = FindText(pBegin, pClose, "encoding");
+		if (p == nullptr)
+			return Utf8;
+		p += 8;
+		while (p != pClose && IsSpace((unsigned char)*p))
+			++p;
+		if (p == pClose || *p++ != '=')
+			return Utf8;
+		while (p != pClose && IsSpace((unsigned char)*p))
+			++p;
+		if (p == pClose || (*p != '"' && *p != '\''))
+			return Utf8;
+		const char * pQuote = std::find(p + 1, pClose, *p);
+		declared = Utilities::StringSpan(p + 1, pQuote - (p + 1));
+		return EncodingNamed(declared);
+	}
+
+	/** Function to Check Whether the First Bytes of Input Handed Over in
+	  * Pieces (Toker::Feed) are Enough For DetectEncoding : a Byte Order
+	  * Mark, or the End of the XML Declaration (or Enough to Know There is
+	  * None).
+	  *
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	bool EncodingKnown(const char * pBegin, const char * pEnd) {
+		const unsigned char * u = (const unsigned char *)pBegin;
+		size_t length = pEnd - pBegin;
+		if (length >= 2 && ((u[0] == 0xFF && u[1] == 0xFE) || (u[0] == 0xFE && u[1] == 0xFF)))
+			return true;
+		if (length >= 3 && u[0] == 0xEF && u[1] == 0xBB && u[2] == 0xBF)
+			return true;
+		if (length < 5)
+			return false;
+		return std::memcmp(pBegin, "<?xml", 5) != 0 || std::memchr(pBegin, '>', length) != nullptr ||
+			length >= kMaxDeclarationBytes;
+	}
+
+	/** Function to Check Whether [p, pEnd) is the Start of a Valid UTF-8
+	  * Character Which Goes On Past pEnd (More Input May Complete it).
+	  *
+	  * Dependant Function(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	bool IsUtf8Prefix(const char * p, const char * pEnd) {
+		const unsigned char * u = (const unsigned char *)p;
+		size_t have = pEnd - p;
+		size_t length = u[0] >= 0xF0 && u[0] <= 0xF4 ? 4 : u[0] >= 0xE0 && u[0] <= 0xEF ? 3 : u[0] >= 0xC2 && u[0] <= 0xDF ? 2 : 0;
+		if (length == 0 || have >= length)
+			return false;
+		if (have > 1) {
+			unsigned char low = u[0] == 0xE0 ? 0xA0 : u[0] == 0xF0 ? 0x90 : 0x80;
+			unsigned char high = u[0] == 0xED ? 0x9F : u[0] == 0xF4 ? 0x8F : 0xBF;
+			if (u[1] < low || u[1] > high)
+				return false;
+		}
+		for (size_t i = 2; i < have; ++i)
+			if ((u[i] & 0xC0) != 0x80)
+				return false;
+		return true;
+	}
+
+	/** Function to Check Whether [pBegin, pEnd) is Read as UTF-8 (Not
+	  * Transcoded).
+	  *
+	  * Dependant Function(s) - DetectEncoding
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	bool IsUtf8Input(const char * pBegin, const char * pEnd) {
+		size_t bomLength;
+		Utilities::StringSpan declared;
+		return DetectEncoding(pBegin, pEnd, bomLength, declared) == Utf8;
+	}
+
+	/** Function to Append [p, pEnd) in Latin-1 or Windows-1252 to out in
+	  * UTF-8. ASCII Runs are Found With the Scanning Kernels and Copied
+	  * Whole.
+	  *
+	  * Dependant Function(s) - ScanKernels::FindNonAscii, AppendUtf8
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void TranscodeSingleByte(const char * p, const char * pEnd, bool windows1252, std::string & out, const ScanKernels & scan) {
+		size_t needed = out.size() + (pEnd - p) + (pEnd - p) / 8;
+		if (out.capacity() < needed)
+			out.reserve(needed);
+		while (p != pEnd) {
+			const char * pRun = scan.FindNonAscii(p, pEnd);
+			out.append(p, pRun);
+			for (p = pRun; p != pEnd && (unsigned char)*p >= 0x80; ++p) {
+				unsigned char ch = (unsigned char)*p;
+				AppendUtf8(windows1252 && ch < 0xA0 ? kWindows1252[ch - 0x80] : ch, out);
+			}
+		}
+	}
+
+	/** Function to Append [p, pEnd) in UTF-16 to out in UTF-8. Returns Where
+	  * it Stopped : pEnd, the Start of a Character Cut Off by pEnd, or
+	  * (Setting invalid) an Unpaired Surrogate. Runs of ASCII are Converted
+	  * Four Code Units at a Time.
+	  *
+	  * Dependant Function(s) - AppendUtf8
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	const char * TranscodeUtf16(const char * p, const char * pEnd, bool bigEndian, std::string & out, bool & invalid) {
+		const int hi = bigEndian ? 0 : 1, lo = 1 - hi;
+		invalid = false;
+		size_t needed = out.size() + (pEnd - p) / 2;
+		if (out.capacity() < needed)
+			out.reserve(needed);
+		while (pEnd - p >= 2) {
+			const unsigned char * u = (const unsigned char *)p;
+			if (pEnd - p >= 8 && (u[hi] | u[hi + 2] | u[hi + 4] | u[hi + 6]) == 0 &&
+				((u[lo] | u[lo + 2] | u[lo + 4] | u[lo + 6]) & 0x80) == 0) {
+				char ascii[4] = { (char)u[lo], (char)u[lo + 2], (char)u[lo + 4], (char)u[lo + 6] };
+				out.append(ascii, 4);
+				p += 8;
+				continue;
+			}
+			unsigned long code = (unsigned long)u[hi] << 8 | u[lo];
+			size_t length = 2;
+			if (code >= 0xD800 && code < 0xDC00) {
+				if (pEnd - p < 4)
+					break;
+				unsigned long low = (unsigned long)u[hi + 2] << 8 | u[lo + 2];
+				if (low < 0xDC00 || low > 0xDFFF) {
+					invalid = true;
+					break;
+				}
+				code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+				length = 4;
+			}
+			else if (code >= 0xDC00 && code < 0xE000) {
+				invalid = true;
+				break;
+			}
+			AppendUtf8(code, out);
+			p += length;
+		}
+		return p;
+	}
+
+	/** Function to Append [p, pEnd) in encoding (Anything But UTF-8) to out
+	  * in UTF-8. Returns Where it Stopped (See TranscodeUtf16).
+	  *
+	  * Dependant Function(s) - TranscodeSingleByte, TranscodeUtf16
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	const char * Transcode(InputEncoding encoding, const char * p, const char * pEnd, std::string & out, const ScanKernels & scan, bool & invalid) {
+		invalid = false;
+		if (encoding == Utf16LE || encoding == Utf16BE)
+			return TranscodeUtf16(p, pEnd, encoding == Utf16BE, out, invalid);
+		TranscodeSingleByte(p, pEnd, encoding == Windows1252, out, scan);
+		return pEnd;
+	}
+}
+
+/*
+ * ----------------------------------------------------------------------
+ *  Pipelined Parsing
+ * ----------------------------------------------------------------------
+ * Toker::ComputePipelined Runs Three Stages on Separate Threads : a Reader
+ * Filling Blocks of the File, the Toker (Begin / Feed / Finish) Turning
+ * the Blocks Into Batches of TokenRecords, and a DocumentBuilder Replaying
+ * the Batches. Blocks and Batches Go Around Between Two Stages in a Pair
+ * of Bounded SPSC Rings (Full One Way, Empty Back), so a Stage Which Gets
+ * Ahead Waits For the Next One Instead of Allocating More.
+ */
+namespace {
+	/* Bytes the Reader Stage Reads at Once */
+	const size_t kReadBlockBytes = 256 << 10;
+	/* A Batch is Handed to the Builder Stage Once it Holds This Many Records or Text Bytes */
+	const size_t kBatchRecords = 4096;
+	const size_t kBatchTextBytes = 64 << 10;
+
+	/** Bounded Single Producer / Single Consumer Ring. One Thread Pushes,
+	  * One Thread Pops; Push Waits While the Ring is Full and Pop While it
+	  * is Empty (Yielding the CPU), Which is What Bounds a Stage.
+	  *
+	  * Dependant Class(es) or Structure(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	template <typename T>
+	class SpscRing {
+	public:
+		explicit SpscRing(size_t capacity) : _slots(capacity + 1), _head(0), _tail(0) {}
+		SpscRing(const SpscRing&) = delete;
+		SpscRing& operator=(const SpscRing&) = delete;
+
+		void Push(T item) {
+			size_t tail = _tail.load(std::memory_order_relaxed);
+			size_t next = tail + 1 == _slots.size() ? 0 : tail + 1;
+			while (next == _head.load(std::memory_order_acquire))
+				std::this_thread::yield();
+			_slots[tail] = item;
+			_tail.store(next, std::memory_order_release);
+		}
+		T Pop() {
+			size_t head = _head.load(std::memory_order_relaxed);
+			while (head == _tail.load(std::memory_order_acquire))
+				std::this_thread::yield();
+			T item = _slots[head];
+			_head.store(head + 1 == _slots.size() ? 0 : head + 1, std::memory_order_release);
+			return item;
+		}
+	private:
+		std::vector<T> _slots;
+		std::atomic<size_t> _head;
+		std::atomic<size_t> _tail;
+	};
+
+	/* Piece of the File Read by the Reader Stage (length 0 : End of File) */
+	struct ReadBlock {
+		std::vector<char> data;
+		size_t length;
+	};
+
+	/* One ParseHandler Event. Names and Values are [offset, offset + length) in TokenBatch::text */
+	struct TokenRecord {
+		enum Kind : unsigned char { Declaration, StartElement, Attribute, Text, EndElement };
+		unsigned char kind;
+		unsigned nameOffset;
+		unsigned nameLength;
+		unsigned valueOffset;
+		unsigned valueLength;
+	};
+
+	/* Records Handed From the Toker Stage to the Builder Stage at Once (last : No More Follow) */
+	struct TokenBatch {
+		std::vector<TokenRecord> records;
+		std::string text;
+		bool last;
+	};
+
+	/** ParseHandler of the Toker Stage. Copies Each Event Into the Current
+	  * TokenBatch and Hands Full Batches Over to the Builder Stage.
+	  *
+	  * Dependant Class(es) or Structure(s) - ParseHandler, SpscRing, TokenBatch
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class BatchWriter : public ParseHandler {
+	public:
+		BatchWriter(SpscRing<TokenBatch *> & full, SpscRing<TokenBatch *> & empty)
+			: _full(full), _empty(empty), _pBatch(empty.Pop()) {}
+
+		virtual void Declaration(const std::string & version, const std::string & encoding) {
+			Add(TokenRecord::Declaration, Utilities::StringSpan(version), Utilities::StringSpan(encoding));
+		}
+		virtual void StartElement(const Utilities::StringSpan & tag) {
+			Add(TokenRecord::StartElement, tag, Utilities::StringSpan());
+		}
+		virtual void Attribute(const Utilities::StringSpan & name, const Utilities::StringSpan & value) {
+			Add(TokenRecord::Attribute, name, value);
+		}
+		virtual void Text(const Utilities::StringSpan & value) {
+			Add(TokenRecord::Text, Utilities::StringSpan(), value);
+		}
+		virtual void EndElement(const Utilities::StringSpan & tag) {
+			Add(TokenRecord::EndElement, tag, Utilities::StringSpan());
+		}
+
+		/* Hands Over the Current Batch (last Marks the End of the Input) */
+		void Flush(bool last) {
+			_pBatch->last = last;
+			_full.Push(_pBatch);
+			_pBatch = last ? nullptr : _empty.Pop();
+		}
+	private:
+		void Add(TokenRecord::Kind kind, const Utilities::StringSpan & name, const Utilities::StringSpan & value) {
+			std::string & text = _pBatch->text;
+			TokenRecord record;
+			record.kind = kind;
+			record.nameOffset = (unsigned)text.size();
+			record.nameLength = (unsigned)name.length;
+			text.append(name.data, name.length);
+			record.valueOffset = (unsigned)text.size();
+			record.valueLength = (unsigned)value.length;
+			text.append(value.data, value.length);
+			_pBatch->records.push_back(record);
+			if (_pBatch->records.size() >= kBatchRecords || text.size() >= kBatchTextBytes)
+				Flush(false);
+		}
+
+		SpscRing<TokenBatch *> & _full;
+		SpscRing<TokenBatch *> & _empty;
+		TokenBatch * _pBatch;
+	};
+
+	/** Function Run by the Reader Stage : Reads (and Decompresses) the File
+	  * Block by Block Into the Blocks Coming Back on empty and Pushes Them on
+	  * full, Then Pushes an Empty Block.
+	  *
+	  * Dependant Function(s) - BlockReader::Read, SpscRing::Pop, SpscRing::Push
+	  *
+	  * Ver : 1.1
+	  *		- Reads Through a BlockReader (Compressed Input).
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void ReadBlocks(BlockReader * pIn, SpscRing<ReadBlock *> * full, SpscRing<ReadBlock *> * empty) {
+		while (true) {
+			ReadBlock * pBlock = empty->Pop();
+			pBlock->length = pIn->Read(pBlock->data.data(), pBlock->data.size());
+			full->Push(pBlock);
+			if (pBlock->length == 0)
+				return;
+		}
+	}
+
+	/** Function Run by the Toker Stage : Feeds the Blocks to the Toker
+	  * (Which Reports to writer) Until the Empty Block, Then Finishes and
+	  * Hands Over the Last Batch.
+	  *
+	  * Dependant Function(s) - Toker::Begin, Toker::Feed, Toker::Finish,
+	  *							BatchWriter::Flush
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void TokenizeBlocks(Toker * pToker, BatchWriter * writer, SpscRing<ReadBlock *> * full, SpscRing<ReadBlock *> * empty) {
+		pToker->Begin(writer);
+		while (true) {
+			ReadBlock * pBlock = full->Pop();
+			if (pBlock->length == 0)
+				break;
+			pToker->Feed(pBlock->data.data(), pBlock->length);
+			empty->Push(pBlock);
+		}
+		pToker->Finish();
+		writer->Flush(true);
+	}
+
+	/** Function to Replay a TokenBatch Into a DocumentBuilder.
+	  *
+	  * Dependant Function(s) - DocumentBuilder::Declaration, DocumentBuilder::StartElement,
+	  *							DocumentBuilder::Attribute, DocumentBuilder::Text,
+	  *							DocumentBuilder::EndElement
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	void BuildBatch(const TokenBatch & batch, DocumentBuilder & builder) {
+		const char * text = batch.text.data();
+		for (const TokenRecord & record : batch.records) {
+			Utilities::StringSpan name(text + record.nameOffset, record.nameLength);
+			Utilities::StringSpan value(text + record.valueOffset, record.valueLength);
+			switch (record.kind) {
+			case TokenRecord::Declaration:	builder.Declaration(name.str(), value.str()); break;
+			case TokenRecord::StartElement:	builder.StartElement(name); break;
+			case TokenRecord::Attribute:	builder.Attribute(name, value); break;
+			case TokenRecord::Text:			builder.Text(value); break;
+			default:						builder.EndElement(name); break;
+			}
+		}
+	}
+}
+
+/*
+ * ----------------------------------------------------------------------
+ *  Streaming Queries
+ * ----------------------------------------------------------------------
+ */
+
+/** Constructor For QueryMatcher Class. A Path query is Split Into its
+  * Steps Here.
+  *
+  * Dependant Function(s) - StringHelper::Split
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+QueryMatcher::QueryMatcher(Kind kind, const std::string & query, MatchHandler * handler, bool subtrees) {
+	_kind = kind;
+	_query = query;
+	_pHandler = handler;
+	_subtrees = subtrees && kind != Value;
+	_pathDepth = 0;
+	_building = std::string::npos;
+	_matches = 0;
+	if (kind == Path)
+		_steps = Utilities::StringHelper::Split(query, '/');
+}
+
+/** Default Destructor For QueryMatcher Class. Deletes the Nodes Kept For
+  * the Levels and a Subtree Left Over by a Truncated Input.
+  *
+  * Dependant Function(s) - DeleteSubtree
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+QueryMatcher::~QueryMatcher() {
+	if (_building != std::string::npos && _building < _open.size()) {
+		for (Node * pChild : _open[_building]->children)
+			DeleteSubtree(pChild);
+	}
+	for (Node * pNode : _levels)
+		delete pNode;
+}
+
+/** Function to Open an Element. Outside a Subtree Which is Being Kept the
+  * Element Reuses the Node of its Level, Otherwise a New Node is Added to
+  * the Subtree. Tag and Path Queries are Decided Here (Path Steps Have to
+  * Match Every Ancestor, so _pathDepth Counts the Open Ancestors Which do).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void QueryMatcher::StartElement(const Utilities::StringSpan & tag) {
+	size_t depth = _open.size();
+	Node * pNode;
+	if (_building != std::string::npos) {
+		pNode = new Node();
+		_open.back()->children.push_back(pNode);
+	}
+	else {
+		if (_levels.size() == depth)
+			_levels.push_back(new Node());
+		pNode = _levels[depth];
+		pNode->value.clear();
+		pNode->attributes.clear();
+	}
+	pNode->tag.assign(tag.data, tag.length);
+	_open.push_back(pNode);
+
+	bool matched = false;
+	if (_kind == Tag)
+		matched = tag == _query;
+	else if (_kind == Path && _pathDepth == depth && depth < _steps.size() &&
+		(_steps[depth] == "*" || tag == _steps[depth])) {
+		_pathDepth++;
+		matched = _pathDepth == _steps.size();
+	}
+	_matched.push_back(matched);
+	if (matched && _subtrees && _building == std::string::npos)
+		_building = depth;
+}
+
+/** Function to Add an Attribute to the Innermost Open Element.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void QueryMatcher::Attribute(const Utilities::StringSpan & name, const Utilities::StringSpan & value) {
+	if (_open.empty())
+		return;
+	_open.back()->attributes.emplace_back(std::piecewise_construct,
+		std::forward_as_tuple(name.data, name.length), std::forward_as_tuple(value.data, value.length));
+}
+
+/** Function to Set the Value of the Innermost Open Element (the Last Text
+  * Wins, as in DocumentBuilder).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void QueryMatcher::Text(const Utilities::StringSpan & value) {
+	if (_open.empty())
+		return;
+	_open.back()->value.assign(value.data, value.length);
+}
+
+/** Function to Close the Innermost Open Element. Value Queries are Decided
+  * Here; a Matching Element is Handed to the MatchHandler. The Subtree
+  * Kept Under a Matching Element is Deleted Once That Element Ends.
+  *
+  * Dependant Function(s) - MatchHandler::Match, DeleteSubtree
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void QueryMatcher::EndElement(const Utilities::StringSpan & /*tag*/) {
+	if (_open.empty())
+		return;
+	size_t depth = _open.size() - 1;
+	Node * pNode = _open.back();
+	bool matched = _kind == Value ? pNode->value == _query : (bool)_matched.back();
+	if (matched) {
+		_matches++;
+		if (_pHandler != nullptr)
+			_pHandler->Match(pNode, depth + 1);
+	}
+	if (_building == depth) {
+		for (Node * pChild : pNode->children)
+			DeleteSubtree(pChild);
+		pNode->children.clear();
+		_building = std::string::npos;
+	}
+	if (_pathDepth > depth)
+		_pathDepth = depth;
+	_open.pop_back();
+	_matched.pop_back();
+}
+
+/** Constructor For Toker Class. This Function Initializes _pContext, 
+  * _pConsumer, VERBOSE and VERBOSE Variable of _pContext too. Also
+  * the Magic Quote Protection is Enabled or Disabled here.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 2.0
+  *		- Modified the Interface.
+  *		- Added Support for MagicQuote Protection & VERBOSE Mode
+  * Ver : 1.0
+  *		- First Release.
+  */
+Toker::Toker(bool verbose, bool MagicQuotes) {
+	_pContext = new Context();
+	_pBuilder = nullptr;
+	_pConsumer = _pContext->_pEatWhitespace;
+	_pConsumer->SetContext(_pContext);
+
+	VERBOSE = verbose;
+	_engine = StateEngine;
+	_lazyValues = false;
+	_tagIndex = false;
+	_pContext->VERBOSE = verbose;
+	_pContext->MagicQuotes = MagicQuotes;
+	if (VERBOSE) {
+		std::cout << "\n [VERBOSE] : Verbose Mode Turned On for Toker";
+		std::cout << "\n [VERBOSE] : Verbose Mode Turned On for Context";
+		if (MagicQuotes)
+			std::cout << "\n [VERBOSE] : Magic Quotes Protection (Read) = Enabled";
+		else
+			std::cout << "\n [VERBOSE] : Magic Quotes Protection (Read) = Disabled";
+		std::cout << "\n [VERBOSE] : Scanning Kernels = " << _pContext->_pScan->name;
+		std::cout << "\n";
+	}
+}
+
+/** Default Destructor for Toker Class. This Function Destroys the _pContext
+  * Variable and Set's it's to Null Pointer to Prevent Memory Leak.
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.1
+  *		- Also Destroys _pBuilder.
+  * Ver : 1.0
+  *		- First Release.
+  */
+Toker::~Toker() {
+	delete _pBuilder;
+	_pBuilder = nullptr;
+	delete _pContext;
+	_pContext = nullptr;
+}
+
+/** Function to Get the Toker Ready For the Next Parse as if it Was Just
+  * Constructed. Settings (Engine, Lazy Values, Projection, Magic Quotes,
+  * State Timing) are Kept. Compute, Parse, Validate and Begin Already
+  * Start From a Clean State, so Reset is Only Needed to Drop an Input Left
+  * by a Begin / Feed Which Was Never Finished, or With releaseBuffers to
+  * Give Back the Memory Kept For the Next Parse (Input Buffer, Scratch
+  * Strings, DocumentBuilder).
+  *
+  * Dependant Function(s) - Toker::Close, Context::Reset
+  *
+  * Ver : 1.1
+  *		- Also Releases the Transcoding Buffers.
+  * Ver : 1.0
+  *		- First Release.
+  */
+void Toker::Reset(bool releaseBuffers) {
+	Close();
+	_pContext->Reset();
+	_error = ParseError();
+	if (releaseBuffers) {
+		std::string().swap(_pContext->_inBuffer);
+		std::string().swap(_pContext->_utf8Buffer);
+		std::string().swap(_pContext->_pendingInput);
+		std::string().swap(_pContext->token);
+		std::string().swap(_pContext->_scratchName);
+		std::string().swap(_pContext->_scratchValue);
+		delete _pBuilder;
+		_pBuilder = nullptr;
+	}
+}
+
+/** Function to Return the DocumentBuilder Compute Builds With, Ready For
+  * a New XMLDocument. The Same One is Reused For Every Compute so its
+  * Scope Stack Does Not Have to Grow Again.
+  *
+  * Dependant Function(s) - DocumentBuilder::Reset, DocumentBuilder::SetTagIndex
+  *
+  * Ver : 1.1
+  *		- Builds the Tag Index When SetTagIndex Asked For it.
+  * Ver : 1.0
+  *		- First Release.
+  */
+DocumentBuilder & Toker::Builder() {
+	if (_pBuilder == nullptr)
+		_pBuilder = new DocumentBuilder(VERBOSE);
+	else
+		_pBuilder->Reset();
+	_pBuilder->SetTagIndex(_tagIndex);
+	return *_pBuilder;
+}
+
+/** Function to Attach File Stream to Toker. Returns True if Valid File Exists
+  * Else It'll Return False. The Stream is Read Into a Buffer Owned by the
+  * Context and the States Scan That Buffer. Also Returns False if the Text
+  * is Not Valid in its Encoding (See AttachInput).
+  *
+  * Dependant Function(s) - Toker::AttachInput
+  *
+  * Ver : 2.2
+  *		- Checks / Transcodes the Encoding (AttachInput).
+  * Ver : 2.1
+  *		- Reads the Whole Stream Into Context::_inBuffer.
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::Attach(std::istream * pIn) {
+	if (pIn != nullptr && pIn->good()) {
+		_pContext->_inBuffer.assign(std::istreambuf_iterator<char>(*pIn), std::istreambuf_iterator<char>());
+		const char * pBegin = _pContext->_inBuffer.data();
+		return AttachInput(pBegin, pBegin + _pContext->_inBuffer.size());
+	}
+	return false;
+}
+
+/** Function to Attach [pBegin, pEnd) to the States After Telling its
+  * Encoding (See Input Encoding Above). UTF-8 is Scanned In Place Once it
+  * Has Been Validated; Latin-1, Windows-1252 and UTF-16 are Transcoded
+  * Into Context::_utf8Buffer, Which is Attached Instead. Compressed Input
+  * is Attached as it is (it is Fed Through Begin / Feed / Finish). Returns
+  * False (With the Error in GetError) if the Encoding is Not Supported or
+  * the Text is Not Valid in it. UTF-8 is Not Validated While
+  * Context::_deferUtf8Check is Set.
+  *
+  * Dependant Function(s) - DetectEncoding, Transcode, State::Attach,
+  *							ScanKernels::FindInvalidUtf8, Toker::InputError
+  *
+  * Ver : 1.1
+  *		- Leaves Validating UTF-8 to the Caller (Context::_deferUtf8Check).
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::AttachInput(const char * pBegin, const char * pEnd) {
+	Context & context = *_pContext;
+	context._transcoded = false;
+	context._inputEncoding = Utf8;
+	if (DetectCompression(pBegin, pEnd) != Uncompressed) {
+		_pConsumer->Attach(pBegin, pEnd);
+		return true;
+	}
+
+	size_t bomLength;
+	Utilities::StringSpan declared;
+	context._inputEncoding = DetectEncoding(pBegin, pEnd, bomLength, declared);
+	if (context._inputEncoding == Utf8) {
+		_pConsumer->Attach(pBegin + bomLength, pEnd);
+		if (context._deferUtf8Check)
+			return true;
+		const char * pInvalid = context._pScan->FindInvalidUtf8(pBegin + bomLength, pEnd);
+		return pInvalid == pEnd || InputError(pInvalid, "Invalid UTF-8");
+	}
+	if (context._inputEncoding == Unsupported) {
+		_pConsumer->Attach(pBegin, pEnd);
+		return InputError(pBegin, "Unsupported Encoding " + declared.str());
+	}
+
+	bool invalid;
+	context._utf8Buffer.clear();
+	const char * pStop = Transcode(context._inputEncoding, pBegin + bomLength, pEnd, context._utf8Buffer, *context._pScan, invalid);
+	const char * pText = context._utf8Buffer.data();
+	_pConsumer->Attach(pText, pText + context._utf8Buffer.size());
+	context._transcoded = true;
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Transcoded " << (pEnd - pBegin) << " Bytes to " << context._utf8Buffer.size() << " Bytes of UTF-8";
+	if (invalid)
+		return InputError(context._pEnd, "Unpaired UTF-16 Surrogate");
+	if (pStop != pEnd)
+		return InputError(context._pEnd, "UTF-16 Input Ends in the Middle of a Character");
+	return true;
+}
+
+/** Function to Record Why the Input Cannot be Read (at pAt, Which is in the
+  * Attached Text so the Line & Column Can be Told) in the Error Returned by
+  * GetError. Always Returns False.
+  *
+  * Dependant Function(s) - Context::Fail
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::InputError(const char * pAt, const std::string & message) {
+	ParseError * pError = _pContext->_pError;
+	_pContext->_pError = &_error;
+	_pContext->Fail(pAt, message);
+	_pContext->_pError = pError;
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Line " << _error.line << ", Column " << _error.column << " : " << _error.message;
+	return false;
+}
+
+/** Function to Add the Next Piece of the Input Handed Over With Feed (or
+  * Finish, With last Set) to Context::_inBuffer in UTF-8 : Until the
+  * Encoding is Known the Bytes are Only Kept; After That UTF-8 is Validated
+  * and Appended, Anything Else is Transcoded. A Character Cut Off by the
+  * End of the Piece Waits in Context::_pendingInput For the Next One.
+  * Returns False (With the Error in GetError) if the Input Cannot be Read.
+  *
+  * Dependant Function(s) - EncodingKnown, DetectEncoding, Transcode,
+  *							IsUtf8Prefix, ScanKernels::FindInvalidUtf8,
+  *							Toker::InputError
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::FeedInput(const char * data, size_t length, bool last) {
+	Context & context = *_pContext;
+	std::string & buffer = context._inBuffer;
+	std::string & pending = context._pendingInput;
+	if (context._inputEncoding == Undecided) {
+		if (length != 0)
+			pending.append(data, length);
+		if (!last && !EncodingKnown(pending.data(), pending.data() + pending.size()))
+			return true;
+		size_t bomLength;
+		Utilities::StringSpan declared;
+		context._inputEncoding = DetectEncoding(pending.data(), pending.data() + pending.size(), bomLength, declared);
+		if (context._inputEncoding == Unsupported)
+			return InputError(context._pEnd, "Unsupported Encoding " + declared.str());
+		context._transcoded = context._inputEncoding != Utf8;
+		pending.erase(0, bomLength);
+		length = 0;
+	}
+
+	size_t cur = context._pCur - context._pBegin;
+	size_t start = buffer.size();
+	bool invalid = false;
+	const char * pInvalid = nullptr;
+	if (context._inputEncoding == Utf8) {
+		buffer.append(pending);
+		pending.clear();
+		if (length != 0)
+			buffer.append(data, length);
+		const char * pEnd = buffer.data() + buffer.size();
+		pInvalid = context._pScan->FindInvalidUtf8(buffer.data() + start, pEnd);
+		if (pInvalid != pEnd && !last && IsUtf8Prefix(pInvalid, pEnd)) {
+			pending.assign(pInvalid, pEnd);
+			buffer.resize(pInvalid - buffer.data());
+			pInvalid = nullptr;
+		}
+		else if (pInvalid == pEnd)
+			pInvalid = nullptr;
+	}
+	else if (pending.empty()) {
+		const char * pStop = Transcode(context._inputEncoding, data, data + length, buffer, *context._pScan, invalid);
+		pending.assign(pStop, data + length);
+	}
+	else {
+		pending.append(data, length);
+		const char * pStop = Transcode(context._inputEncoding, pending.data(), pending.data() + pending.size(), buffer, *context._pScan, invalid);
+		pending.erase(0, pStop - pending.data());
+	}
+
+	context._pBegin = buffer.data();
+	context._pCur = context._pBegin + cur;
+	context._pEnd = context._pBegin + buffer.size();
+	if (pInvalid != nullptr)
+		return InputError(pInvalid, "Invalid UTF-8");
+	if (invalid)
+		return InputError(context._pEnd, "Unpaired UTF-16 Surrogate");
+	if (last && !pending.empty())
+		return InputError(context._pEnd, "UTF-16 Input Ends in the Middle of a Character");
+	return true;
+}
+
+/** Function to Choose Which Engine Compute Runs. Both Produce the Same
+  * XMLDocument :
+  *		- StateEngine : State Classes, Virtual EatChars + State::NextState.
+  *		- TableEngine : Transition Table Over Character Classes (Dfa::Run).
+  *
+  * Dependant Function(s) - N/A
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void Toker::SetEngine(Engine engine) {
+	_engine = engine;
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Engine = " << (engine == TableEngine ? "Table Driven" : "State Classes");
+}
+
+/** Function to Return Token From _pConsumer. Will return String.
+  * 
+  * Dependant Function(s) - State::CanRead, State::ConsumeChars, 
+  *							State::HasTok, State::GetTok
+  *
+  * Ver : 2.1
+  *		- Moved the Loop to Toker::NextTok.
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::string Toker::GetTok() {
+	if (!NextTok())
+		return "";
+	return _pConsumer->GetTok();
+}
+
+/** Function to Advance to the Next Token Without Copying it. Returns False
+  * When There is Nothing More to Read.
+  * 
+  * Dependant Function(s) - State::CanRead, State::ConsumeChars, State::HasTok
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::NextTok() {
+	while (true) {
+		if (!_pConsumer->CanRead())
+			return false;
+		_pConsumer->ConsumeChars();
+		if (_pConsumer->HasTok())
+			return true;
+	}
+}
+
+/** Function to Check if We Can Read From XML File. Returns True
+  * if we can Read Data else it'll Return False.
+  *
+  * Dependant Function(s) - State::CanRead
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::CanRead() {
+	return _pConsumer->CanRead();
+}
+
+/** Function to Return The Number of Lines Read From the Input File
+  * Stream.
+  *
+  * Dependant Function(s) - State::CurrentLineCount
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+size_t Toker::CurrentLineCount() {
+	return _pConsumer->CurrentLineCount();
+}
+
+/** Function to Open the Input File. The File is Memory Mapped so the States
+  * Scan it In Place. If it Cannot be Mapped (e.g. Not a Regular File) it is
+  * Read Through an ifstream. Returns False if the File Cannot be Opened
+  * or its Text is Not Valid in its Encoding (See AttachInput).
+  *
+  * Dependant Function(s) - MappedFile::Open, Toker::AttachInput, Toker::Attach
+  *
+  * Ver : 1.2
+  *		- Checks / Transcodes the Encoding (AttachInput).
+  * Ver : 1.1
+  *		- Says Why it Failed in the Error (Toker::GetError).
+  * Ver : 1.0
+  *		- First Release (Moved Out of Toker::Compute).
+  */
+bool Toker::Open(const std::string & fileSpec) {
+	_error = ParseError();
+	if (_pContext->_map.Open(fileSpec)) {
+		const char * pBegin = _pContext->_map.Data();
+		if (VERBOSE)
+			std::cout << "\n [VERBOSE] : Memory Mapped " << _pContext->_map.Size() << " Bytes From " << fileSpec;
+		if (AttachInput(pBegin, pBegin + _pContext->_map.Size()))
+			return true;
+		Close();
+		return false;
+	}
+
+	std::ifstream inFile(fileSpec);
+	if (!inFile.good())
+	{
+		std::cout << "\n  can't open " << fileSpec << "\n\n ";
+		_error.message = "Can't Open " + fileSpec;
+		return false;
+	}
+	if (Attach(&inFile))
+		return true;
+	Close();
+	return false;
+}
+
+/** Function to Run the Selected Engine Over the Attached Input Until it
+  * is Exhausted.
+  *
+  * Dependant Function(s) - Dfa::Run, Toker::NextTok, Toker::CurrentLineCount
+  *
+  * Ver : 1.3
+  *		- Applies the Projection (SetProjection).
+  * Ver : 1.2
+  *		- Collects the Parse Statistics.
+  * Ver : 1.1
+  *		- Tokens are No Longer Printed in VERBOSE Mode (Traced With XML_TRACE).
+  * Ver : 1.0
+  *		- First Release (Moved Out of Toker::Compute).
+  */
+void Toker::Run() {
+	_pContext->_pProjection = _projection.empty() ? nullptr : &_projection;
+	if (_engine == TableEngine) {
+		if (VERBOSE)
+			std::cout << "\n [VERBOSE] : Using Table Driven Engine";
+		Dfa::Run(_pContext);
+	}
+	else {
+		do
+		{
+			NextTok();
+		} while (CanRead());
+	}
+	_pContext->_pProjection = nullptr;
+	CollectStats();
+	if (VERBOSE)
+		std::cout << "\n Line Count : " << CurrentLineCount();
+}
+
+/** Function to Release the Input (Unmap the File / Empty the Buffers).
+  *
+  * Dependant Function(s) - MappedFile::Close
+  *
+  * Ver : 1.2
+  *		- Also Empties the Transcoding Buffer.
+  * Ver : 1.1
+  *		- The Buffer Keeps its Memory For the Next Parse (See Reset).
+  * Ver : 1.0
+  *		- First Release (Moved Out of Toker::Compute).
+  */
+void Toker::Close() {
+	_pContext->_map.Close();
+	_pContext->_inBuffer.clear();
+	_pContext->_utf8Buffer.clear();
+	_pContext->tok = Utilities::StringSpan();
+}
+
+/** Function to Read XML File Token By Token and Report What it Reads to
+  * handler (See ParseHandler). No XMLDocument is Built. A gzip / zstd
+  * Compressed File is Decompressed a Block at a Time (See ParseCompressed).
+  * Returns False if the File Cannot be Opened.
+  *
+  * Dependant Function(s) - Toker::Open, Toker::Run, Toker::Close,
+  *							Toker::ParseCompressed, DetectCompression
+  *
+  * Ver : 1.1
+  *		- Reads Compressed Files.
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::Parse(std::string fileSpec, ParseHandler * handler) {
+	if (handler == nullptr)
+		return false;
+	if (!Open(fileSpec))
+		return false;
+	if (DetectCompression(_pContext->_pBegin, _pContext->_pEnd) != Uncompressed) {
+		Close();
+		return ParseCompressed(fileSpec, handler);
+	}
+	_pContext->_pHandler = handler;
+	Run();
+	Close();
+	_pContext->_pHandler = nullptr;
+	return true;
+}
+
+/** Function to Parse a Compressed File : it is Decompressed kReadBlockBytes
+  * at a Time and Each Block is Fed to the Toker (Begin / Feed / Finish),
+  * so Neither the Compressed Nor the Decompressed Text is Ever Held Whole.
+  * Returns False if it Cannot be Opened, its Data is Corrupt or the Text
+  * is Not Valid in its Encoding.
+  *
+  * Dependant Function(s) - OpenBlockReader, BlockReader::Read, Toker::Begin,
+  *							Toker::Feed, Toker::Finish
+  *
+  * Ver : 1.1
+  *		- Stops Reading When Feed Fails (Encoding Error).
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::ParseCompressed(const std::string & fileSpec, ParseHandler * handler) {
+	BlockReader * pIn = OpenBlockReader(fileSpec, _error.message);
+	if (pIn == nullptr)
+		return false;
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Decompressing " << fileSpec;
+	std::vector<char> block(kReadBlockBytes);
+	Begin(handler);
+	size_t length;
+	bool fed = true;
+	while (fed && (length = pIn->Read(block.data(), block.size())) > 0)
+		fed = Feed(block.data(), length);
+	bool finished = Finish();
+	bool failed = pIn->Failed();
+	delete pIn;
+	if (failed) {
+		std::cout << "\n  corrupt compressed data in " << fileSpec << "\n\n ";
+		_error.message = "Corrupt Compressed Data";
+	}
+	return finished && !failed;
+}
+
+/** Function to Check That a Compressed File is Well Formed : Like
+  * ParseCompressed it is Decompressed kReadBlockBytes at a Time and Each
+  * Block is Fed to the Toker, Here in Validation Mode (Finish Then Checks
+  * That Every Element Was Closed). Reading Stops at the First Error.
+  *
+  * Dependant Function(s) - OpenBlockReader, BlockReader::Read, Toker::Begin,
+  *							Context::BeginValidation, Toker::Feed, Toker::Finish
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::ValidateCompressed(const std::string & fileSpec) {
+	BlockReader * pIn = OpenBlockReader(fileSpec, _error.message);
+	if (pIn == nullptr)
+		return false;
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Decompressing " << fileSpec;
+	ParseHandler ignored;
+	std::vector<char> block(kReadBlockBytes);
+	Begin(&ignored);
+	_pContext->BeginValidation(&_error);
+	size_t length;
+	bool fed = true;
+	while (fed && (length = pIn->Read(block.data(), block.size())) > 0)
+		fed = Feed(block.data(), length);
+	Finish();
+	bool failed = pIn->Failed();
+	delete pIn;
+	_pContext->_pError = nullptr;
+	if (failed) {
+		_error = ParseError();
+		_error.message = "Corrupt Compressed Data";
+	}
+	if (VERBOSE && !_error.message.empty())
+		std::cout << "\n [VERBOSE] : Line " << _error.line << ", Column " << _error.column << " : " << _error.message;
+	return _error.message.empty();
+}
+
+/** Function to Read XML Text Which is Already in Memory and Report What
+  * it Reads to handler. UTF-8 Text is Scanned In Place (Not Copied) and Must
+  * Stay Valid Until Parse Returns; Text in Other Encodings is Transcoded
+  * First. Returns False if handler is nullptr or the Text is Not Valid in
+  * its Encoding (See GetError).
+  *
+  * Dependant Function(s) - Toker::AttachInput, Toker::Run
+  *
+  * Ver : 1.1
+  *		- Checks / Transcodes the Encoding (AttachInput).
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::Parse(const char * data, size_t length, ParseHandler * handler) {
+	if (handler == nullptr || (data == nullptr && length != 0))
+		return false;
+	_error = ParseError();
+	if (!AttachInput(data, data + length)) {
+		_pContext->tok = Utilities::StringSpan();
+		return false;
+	}
+	_pContext->_pHandler = handler;
+	Run();
+	_pContext->_pHandler = nullptr;
+	_pContext->tok = Utilities::StringSpan();
+	return true;
+}
+
+/** Function to Generate a XML Document From XML Text Which is Already in
+  * Memory. The Text is Scanned In Place (Not Copied). The Caller Owns the
+  * Returned XMLDocument. With Lazy Values the Nodes Refer to the Text, so
+  * it Has to Stay Valid as Long as the XMLDocument (Text Which is Not UTF-8
+  * is Transcoded, so its Values are Decoded Right Away).
+  *
+  * Dependant Function(s) - Toker::Parse, Toker::Builder, DocumentBuilder::Release
+  *
+  * Ver : 1.2
+  *		- Lazy Values Only For UTF-8 Text.
+  * Ver : 1.1
+  *		- Reuses the Toker's DocumentBuilder.
+  * Ver : 1.0
+  *		- First Release.
+  */
+XMLDocument * Toker::Compute(const char * data, size_t length) {
+	if (_lazyValues && IsUtf8Input(data, data + length))
+		return ComputeLazy(new LazySource(_pContext->MagicQuotes), data, length);
+	DocumentBuilder & builder = Builder();
+	if (!Parse(data, length, &builder))
+		return nullptr;
+	return builder.Release();
+}
+
+/** Function to Run a Streaming Query Over an XML File : Every Element the
+  * QueryMatcher Matches is Handed to its MatchHandler While the File is
+  * Read, and No XMLDocument is Built. For Path Queries the Path Also
+  * Serves as the Projection (Replacing SetProjection's Until Query
+  * Returns), so Subtrees Off the Path are Skipped Without Being Read.
+  * Returns False if the File Cannot be Opened.
+  *
+  * Dependant Function(s) - Toker::Parse
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::Query(std::string fileSpec, QueryMatcher * matcher) {
+	if (matcher == nullptr)
+		return false;
+	std::vector<std::vector<std::string>> projection;
+	if (matcher->GetKind() == QueryMatcher::Path) {
+		projection.swap(_projection);
+		SetProjection(std::vector<std::string>(1, matcher->GetQuery()));
+	}
+	bool parsed = Parse(fileSpec, matcher);
+	if (matcher->GetKind() == QueryMatcher::Path)
+		_projection.swap(projection);
+	return parsed;
+}
 
-		pos = Utilities::StringHelper::FindSubStr(nospace, "encoding=\"");
-		if (pos != -1) {
-			pos += 10;
-			std::string enc;
-			for (size_t i = pos; nospace[i] != '"'; i++) {
-				enc.push_back(nospace[i]);
-			}
-			_pContext->_encoding = enc;
-			_pContext->xDoc->setEncoding(enc);
-		}
+/** Function to Check That an XML File is Well Formed Without Building a
+  * Tree : There is One Root Element and no Text Outside it, Tags are
+  * Balanced, Attributes are Written name="value" (or With Single Quotes)
+  * and do Not Repeat, and the XML Declaration (if Any) is Valid. Comments, CDATA Sections and DOCTYPE are Skipped. Stops at the
+  * First Error, Which GetError Returns. Returns True if the File is Well
+  * Formed. Always Uses the Table Driven Engine. A gzip / zstd Compressed
+  * File is Validated a Decompressed Block at a Time (See
+  * ValidateCompressed). Text Which is Not Valid in its Encoding is Not
+  * Validated.
+  *
+  * Dependant Function(s) - Toker::Open, Toker::RunValidation, Toker::Close,
+  *							Toker::ValidateCompressed, DetectCompression
+  *
+  * Ver : 1.3
+  *		- Validates Compressed Files (Rejected Before).
+  * Ver : 1.2
+  *		- Keeps the Error Open Gives (Encoding Errors).
+  * Ver : 1.1
+  *		- Rejects Compressed Files.
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::Validate(std::string fileSpec) {
+	_error = ParseError();
+	if (!Open(fileSpec))
+		return false;
+	if (DetectCompression(_pContext->_pBegin, _pContext->_pEnd) != Uncompressed) {
+		Close();
+		return ValidateCompressed(fileSpec);
 	}
+	bool valid = RunValidation();
+	Close();
+	return valid;
+}
 
-	/** Function to Remove All Whitespaces in a String.
-	  *
-	  * Dependant Function(s) - N/A
-	  *
-	  * Ver : 1.0
-	  *		- First Release.
-	  */
-	std::string RemoveAllWnitespaces(std::string src) {
-		std::string str;
-		for (char ch : src) {
-			if (std::isspace(ch))
-				continue;
-			str.push_back(ch);
-		}
-		return str;
+/** Function to Check That XML Text Already in Memory is Well Formed (See
+  * Validate(fileSpec)).
+  *
+  * Dependant Function(s) - Toker::AttachInput, Toker::RunValidation
+  *
+  * Ver : 1.1
+  *		- Checks / Transcodes the Encoding (AttachInput).
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::Validate(const char * data, size_t length) {
+	_error = ParseError();
+	if (data == nullptr && length != 0) {
+		_error.message = "No Input";
+		return false;
 	}
-};
+	if (!AttachInput(data, data + length)) {
+		_pContext->tok = Utilities::StringSpan();
+		return false;
+	}
+	bool valid = RunValidation();
+	_pContext->tok = Utilities::StringSpan();
+	return valid;
+}
 
-/** Default Constructor For Context Structure. This Function
-  * will Initialize All the States, XML Document Elements, 
-  * Scope, MagicQuotes Protection Enable/Disable and MagicQuotesR
-  * Vector Initialization.
+/** Function to Return the Error Found by the Last Validate, or Why the
+  * Last Compute / Parse of a File Failed.
   *
   * Dependant Function(s) - N/A
   *
+  * Ver : 1.1
+  *		- Also Says Why a File Could Not be Opened or Decompressed.
   * Ver : 1.0
   *		- First Release.
   */
-Context::Context() {
-	_pEatValue = new EatValue(this);
-	_pEatHeaders = new EatHeaders(this);
-	_pEatOpenTag = new EatOpenTag(this);
-	_pEatCloseTag = new EatCloseTag(this);
-	_pEatWhitespace = new EatWhitespace(this);
-	_pState = _pEatWhitespace;
-	_lineCount = 0;	
-	
-	xDoc = new XMLDocument();
-	_scope.push(xDoc->getRoot());
+const ParseError & Toker::GetError() const {
+	return _error;
+}
 
-	MagicQuotes = false;
+/** Function to Run the Table Driven Engine in Validation Mode Over the
+  * Attached Input, Then Check That Every Element Was Closed.
+  *
+  * Dependant Function(s) - Context::BeginValidation, Dfa::Run,
+  *							Context::ValidateEnd, Toker::CollectStats
+  *
+  * Ver : 1.1
+  *		- The Checks at the End Moved to Context::ValidateEnd.
+  * Ver : 1.0
+  *		- First Release.
+  */
+bool Toker::RunValidation() {
+	ParseHandler ignored;
+	_pContext->_pHandler = &ignored;
+	_pContext->BeginValidation(&_error);
 
-	/* XML Protection Mechanism While Reading From Disk */
-	MagicQuotesR.insert(std::make_pair(";opBracket", "<"));
-	MagicQuotesR.insert(std::make_pair(";clBracket", ">"));
-	MagicQuotesR.insert(std::make_pair(";dbQuotes", "\""));
-	MagicQuotesR.insert(std::make_pair(";bkSlash", "/"));
-	MagicQuotesR.insert(std::make_pair(";nlWhiteSpace", "\n"));
-	MagicQuotesR.insert(std::make_pair(";tbWhiteSpace", "\t"));
-	MagicQuotesR.insert(std::make_pair(";eqSymbol", "\t"));
+	Dfa::Run(_pContext);
+	_pContext->ValidateEnd();
+	CollectStats();
+
+	_pContext->_pError = nullptr;
+	_pContext->_pHandler = nullptr;
+	if (VERBOSE && !_error.message.empty())
+		std::cout << "\n [VERBOSE] : Line " << _error.line << ", Column " << _error.column << " : " << _error.message;
+	return _error.message.empty();
 }
 
-/** Default Destructor For Context Structure. This Function
-  * will Delete All the Created States.
+/** Function to Choose Whether Compute Decodes Values Right Away (Default)
+  * or Leaves Text and Attribute Values in the Input Until They are First
+  * Read (Node::GetValue, Node::GetAttributes). Tags and Attribute Names are
+  * Always Decoded. ComputeParallel, Parse and Feed Always Decode.
   *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-Context::~Context() {
-	delete _pEatValue;
-	delete _pEatHeaders;
-	delete _pEatOpenTag;
-	delete _pEatCloseTag;
-	delete _pEatWhitespace;
+void Toker::SetLazyValues(bool lazy) {
+	_lazyValues = lazy;
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Lazy Values = " << (lazy ? "Enabled" : "Disabled");
 }
 
-/** Default Constructor For State Class. It Does Nothing.
-  * 
+/** Function to Choose Whether the XMLDocuments Compute, ComputeParallel
+  * and ComputePipelined Build Come With the Tag Index (Off by Default; See
+  * XMLDocument::SetTagIndex). The Index is Then Kept Up to Date as Nodes
+  * are Added, Instead of Being Built by the First Query.
+  *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-State::State() {};
-
+void Toker::SetTagIndex(bool indexed) {
+	_tagIndex = indexed;
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Tag Index = " << (indexed ? "Enabled" : "Disabled");
+}
 
-/** Default Destructor For State Class. It Does Nothing.
+/** Function to Turn Timing of Each State On or Off (Off by Default). The
+  * Time Spent in Each State Shows Up in GetStats().cycles. Reading the
+  * Time Stamp Counter Around Every Token Costs Some Speed.
   *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-State::~State() {};
+void Toker::SetStateTiming(bool timing) {
+	_pContext->_timeStates = timing;
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : State Timing = " << (timing ? "Enabled" : "Disabled");
+}
 
+/** Function to Restrict Compute and Parse to Some Elements. Each Path is
+  * a List of Tags Separated by '/' Starting at a Top Level Element (e.g.
+  * "Movies/Actor"); "*" Stands For Any Tag. Elements Matching a Path are
+  * Read Whole (With Everything Inside Them), Elements on the Way to One
+  * Keep Their Attributes and Text, and Every Other Subtree is Skipped
+  * Without Being Tokenized. An Empty List Turns the Projection Off (the
+  * Default). Validate and Begin / Feed / Finish Ignore the Projection, and
+  * ComputeParallel Falls Back to Compute.
+  *
+  * Dependant Function(s) - StringHelper::Split
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void Toker::SetProjection(const std::vector<std::string> & paths) {
+	_projection.clear();
+	for (const std::string & path : paths) {
+		std::vector<std::string> steps = Utilities::StringHelper::Split(path, '/');
+		if (!steps.empty())
+			_projection.push_back(steps);
+	}
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Projection = " << _projection.size() << " Path(s)";
+}
 
-/** Constructor For Toker Class. This Function Initializes _pContext, 
-  * _pConsumer, VERBOSE and VERBOSE Variable of _pContext too. Also
-  * the Magic Quote Protection is Enabled or Disabled here.
+/** Function to Return the Statistics of the Last Parse (Compute, Parse,
+  * ComputeParallel or Begin / Feed / Finish).
   *
   * Dependant Function(s) - N/A
   *
-  * Ver : 2.0
-  *		- Modified the Interface.
-  *		- Added Support for MagicQuote Protection & VERBOSE Mode
   * Ver : 1.0
   *		- First Release.
   */
-Toker::Toker(bool verbose, bool MagicQuotes) {
-	_pContext = new Context();
-	_pConsumer = _pContext->_pEatWhitespace;
-	_pConsumer->SetContext(_pContext);
-
-	VERBOSE = verbose;
-	_pContext->VERBOSE = verbose;
-	_pContext->MagicQuotes = MagicQuotes;
-	_pContext->xDoc->SetVerbose(VERBOSE);
-	if (VERBOSE) {
-		std::cout << "\n [VERBOSE] : Verbose Mode Turned On for Toker";
-		std::cout << "\n [VERBOSE] : Verbose Mode Turned On for Context";
-		if (MagicQuotes)
-			std::cout << "\n [VERBOSE] : Magic Quotes Protection (Read) = Enabled";
-		else
-			std::cout << "\n [VERBOSE] : Magic Quotes Protection (Read) = Disabled";
-		std::cout << "\n";
-	}
+const ParseStats & Toker::GetStats() const {
+	return _pContext->_stats;
 }
 
-/** Default Destructor for Toker Class. This Function Destroys the _pContext
-  * Variable and Set's it's to Null Pointer to Prevent Memory Leak.
+/** Function to Complete the Statistics at the End of a Parse (Bytes Read,
+  * Maximum Depth and the Parser's Own Buffers).
   *
   * Dependant Function(s) - N/A
   *
   * Ver : 1.0
   *		- First Release.
   */
-Toker::~Toker() {
-	delete _pContext;
-	_pContext = nullptr;
+void Toker::CollectStats() {
+	ParseStats & stats = _pContext->_stats;
+	stats.bytes += _pContext->_pCur - _pContext->_pBegin;
+	stats.maxDepth = _pContext->_maxDepth > 0 ? _pContext->_maxDepth : 0;
+	stats.bytesAllocated += _pContext->_inBuffer.capacity() + _pContext->_utf8Buffer.capacity() + _pContext->token.capacity() +
+		_pContext->_scratchName.capacity() + _pContext->_scratchValue.capacity();
+	stats.timed = _pContext->_timeStates;
 }
 
-/** Function to Attach File Stream to Toker. Returns True if Valid File Exists
-  * Else It'll Return False.
+/** Function to Build an XMLDocument With Lazy Values Over [data, data + length).
+  * The XMLDocument Takes Over source.
   *
-  * Dependant Function(s) - State::Attach
+  * Dependant Function(s) - DocumentBuilder::SetRawSource, Toker::Parse, Toker::Builder
   *
+  * Ver : 1.1
+  *		- Reuses the Toker's DocumentBuilder.
   * Ver : 1.0
   *		- First Release.
   */
-bool Toker::Attach(std::istream * pIn) {
-	if (pIn != nullptr && pIn->good()) {
-		_pConsumer->Attach(pIn);
-		return true;
-	}
-	return false;
+XMLDocument * Toker::ComputeLazy(RawSource * source, const char * data, size_t length) {
+	DocumentBuilder & builder = Builder();
+	builder.SetRawSource(source, data, data + length);
+	_pContext->_lazyValues = true;
+	bool parsed = Parse(data, length, &builder);
+	_pContext->_lazyValues = false;
+	if (!parsed)
+		return nullptr;
+	return builder.Release();
 }
 
-/** Function to Return Token From _pConsumer. Will return String.
-  * 
-  * Dependant Function(s) - State::CanRead, State::ConsumeChars, 
-  *							State::HasTok, State::GetTok
+/** Function to Start Parsing Input Which Will be Handed Over Piece by
+  * Piece With Feed. The Pieces Can be Split Anywhere (Even in the Middle
+  * of a Tag, or of a Character). Events Go to handler, Just Like Parse.
+  * Returns False if handler is nullptr.
+  *
+  * Dependant Function(s) - State::Attach
   *
+  * Ver : 1.1
+  *		- Starts With the Encoding Unknown (Told by the First Bytes Fed).
   * Ver : 1.0
   *		- First Release.
   */
-std::string Toker::GetTok() {
-	while (true) {
-		if (!_pConsumer->CanRead())
-			return  "";
-		_pConsumer->ConsumeChars();
-		if (_pConsumer->HasTok())
-			break;
-	}
-	return _pConsumer->GetTok();
+bool Toker::Begin(ParseHandler * handler) {
+	if (handler == nullptr)
+		return false;
+	_error = ParseError();
+	_pContext->_inBuffer.clear();
+	_pContext->_pendingInput.clear();
+	_pContext->_inputEncoding = Undecided;
+	_pContext->_transcoded = false;
+	const char * pBegin = _pContext->_inBuffer.data();
+	_pConsumer->Attach(pBegin, pBegin);
+	_pContext->_resume = Dfa::Headers;
+	_pContext->_pHandler = handler;
+	return true;
 }
 
-/** Function to Check if We Can Read From XML File. Returns True
-  * if we can Read Data else it'll Return False.
+/** Function to Parse the Next length Bytes of the Input Started With
+  * Begin. Every Token Which Ends Inside the Bytes Received so Far is
+  * Reported Right Away; the Rest is Kept Until More Bytes Arrive (or
+  * Finish). Always Uses the Table Driven Engine. Returns False if Begin
+  * Was Not Called or the Input is Not Valid in its Encoding (See GetError;
+  * Every Later Feed Then Returns False Too).
   *
-  * Dependant Function(s) - State::CanRead
+  * Dependant Function(s) - Toker::FeedInput, Dfa::Pump
   *
+  * Ver : 1.1
+  *		- Input is Validated / Transcoded to UTF-8 (FeedInput).
   * Ver : 1.0
   *		- First Release.
   */
-bool Toker::CanRead() {
-	return _pConsumer->CanRead();
+bool Toker::Feed(const char * data, size_t length) {
+	if (_pContext->_pHandler == nullptr || !_error.message.empty())
+		return false;
+	if (!FeedInput(data, length, false))
+		return false;
+	std::string & buffer = _pContext->_inBuffer;
+	Dfa::Pump(_pContext, false);
+
+	/* Drop What Has Been Read, Except the Current Character (EatValue Starts There) */
+	size_t used = _pContext->_pCur - _pContext->_pBegin;
+	if (used > 1) {
+		const char * pLine = _pContext->_pBegin + used - 1;
+		while (pLine != _pContext->_pBegin && pLine[-1] != '\n')
+			--pLine;
+		_pContext->_columnBase = pLine == _pContext->_pBegin ? _pContext->_columnBase + used - 1 : _pContext->_pBegin + used - 1 - pLine;
+		_pContext->_stats.bytes += used - 1;
+		buffer.erase(0, used - 1);
+		_pContext->_pBegin = buffer.data();
+		_pContext->_pCur = _pContext->_pBegin + 1;
+		_pContext->_pEnd = _pContext->_pBegin + buffer.size();
+	}
+	return true;
 }
 
-/** Function to Return The Number of Lines Read From the Input File
-  * Stream.
+/** Function to End the Input Started With Begin. Whatever is Left is
+  * Parsed as the End of the File. Returns False if Begin Was Not Called or
+  * the Input Was Not Valid in its Encoding (See GetError).
   *
-  * Dependant Function(s) - State::CurrentLineCount
+  * Dependant Function(s) - Toker::FeedInput, Dfa::Pump, Context::ValidateEnd,
+  *							Toker::CollectStats
   *
+  * Ver : 1.4
+  *		- Ends a Validation Too (See ValidateCompressed).
+  * Ver : 1.3
+  *		- Decodes What Was Held Back For the Encoding (FeedInput).
+  * Ver : 1.2
+  *		- The Buffer Keeps its Memory For the Next Parse (See Reset).
+  * Ver : 1.1
+  *		- Collects the Parse Statistics.
   * Ver : 1.0
   *		- First Release.
   */
-size_t Toker::CurrentLineCount() {
-	return _pConsumer->CurrentLineCount();
+bool Toker::Finish() {
+	if (_pContext->_pHandler == nullptr)
+		return false;
+	bool decoded = _error.message.empty() && FeedInput(nullptr, 0, true);
+	if (decoded) {
+		Dfa::Pump(_pContext, true);
+		_pContext->ValidateEnd();
+	}
+	CollectStats();
+	if (VERBOSE)
+		std::cout << "\n Line Count : " << CurrentLineCount();
+	_pContext->_pHandler = nullptr;
+	_pContext->_inBuffer.clear();
+	_pContext->_pendingInput.clear();
+	_pContext->tok = Utilities::StringSpan();
+	return decoded;
 }
 
 /** Function to Read XML File Token By Token And Generate a XML Document.
+  * The Caller Owns the Returned XMLDocument.
   * 
-  * Dependant Function(s) - Toker::Attach, Toker::GetTok,
-  *							Toker::CurrentLineCount
+  * Dependant Function(s) - Toker::Parse, Toker::Builder, DocumentBuilder::Release
   *
+  * Ver : 2.8
+  *		- Lazy Values are Only Used For UTF-8 Files (Others are Transcoded).
+  * Ver : 2.7
+  *		- Reuses the Toker's DocumentBuilder.
+  * Ver : 2.6
+  *		- Reads Compressed Files (Through Parse; Lazy Values are Not Used
+  *		  For Them Since the Text is Never Held Whole).
+  * Ver : 2.5
+  *		- With Lazy Values the Input is Kept by the XMLDocument (LazySource).
+  * Ver : 2.4
+  *		- Builds the XMLDocument With a DocumentBuilder Through Toker::Parse.
+  * Ver : 2.3
+  *		- Runs the Engine Chosen With SetEngine.
+  * Ver : 2.1
+  *		- Memory Maps the Input File.
+  *		- Token is Only Copied to a String When VERBOSE Mode is On.
   * Ver : 2.0
   *		- Added Support for VERBOSE Mode.
   * Ver : 1.0
   *		- First Release.
   */
 XMLDocument * Toker::Compute(std::string fileSpec) {
-	std::ifstream inFile(fileSpec);
-	if (!inFile.good())
-	{
-		std::cout << "\n  can't open " << fileSpec << "\n\n ";
+	if (_lazyValues) {
+		LazySource * source = new LazySource(_pContext->MagicQuotes);
+		if (!source->Load(fileSpec)) {
+			std::cout << "\n  can't open " << fileSpec << "\n\n ";
+			_error = ParseError();
+			_error.message = "Can't Open " + fileSpec;
+			delete source;
+			return nullptr;
+		}
+		if (DetectCompression(source->Data(), source->Data() + source->Size()) == Uncompressed &&
+			IsUtf8Input(source->Data(), source->Data() + source->Size()))
+			return ComputeLazy(source, source->Data(), source->Size());
+		delete source;
+	}
+	DocumentBuilder & builder = Builder();
+	if (!Parse(fileSpec, &builder))
+		return nullptr;
+	return builder.Release();
+}
+
+/** Function to Generate a XML Document Using Several Threads. The Input is
+  * Split Into Chunks at '<' Characters, Each Chunk is Parsed by its Own
+  * Thread (Table Driven Engine) Into Subtrees, and the Subtrees are Stitched
+  * Together in Document Order. The Result is the Same as Compute.
+  * If a Chunk Did Not Start at a Tag (a '<' Inside a Tag or the Header) the
+  * Chunks are Thrown Away and the File is Processed by Compute.
+  * threads = 0 Uses One Thread per Core, But Not Less Than kMinChunkBytes
+  * per Thread. The Caller Owns the Returned XMLDocument. UTF-8 Input is
+  * Validated by the Chunks, Each Over its Own Range, Rather Than Up Front;
+  * the Error is the One in the Earliest Chunk Which Has One.
+  *
+  * Dependant Function(s) - Toker::Open, Toker::Close, Toker::Compute,
+  *							Toker::InputError, SplitChunks, ParseChunk,
+  *							ChunkBuilder::Stitch
+  *
+  * Ver : 1.5
+  *		- The Chunks Validate the UTF-8 (No Single Threaded Pass First).
+  * Ver : 1.4
+  *		- Builds the Tag Index When SetTagIndex Asked For it.
+  * Ver : 1.3
+  *		- Chunks Transcoded Input (Reported as UTF-8).
+  * Ver : 1.2
+  *		- Falls Back to Compute For Compressed Files.
+  * Ver : 1.1
+  *		- Falls Back to Compute When a Projection is Set (a Chunk Cannot
+  *		  Know Which Elements Enclose it).
+  * Ver : 1.0
+  *		- First Release.
+  */
+XMLDocument * Toker::ComputeParallel(std::string fileSpec, unsigned threads) {
+	if (!_projection.empty())
+		return Compute(fileSpec);
+	_pContext->_deferUtf8Check = true;
+	bool opened = Open(fileSpec);
+	_pContext->_deferUtf8Check = false;
+	if (!opened)
 		return nullptr;
+	const char * pBegin = _pContext->_pBegin;
+	const char * pEnd = _pContext->_pEnd;
+	bool transcoded = _pContext->_transcoded;
+	if (DetectCompression(pBegin, pEnd) != Uncompressed) {
+		Close();
+		return Compute(fileSpec);
+	}
+	size_t count = threads;
+	if (count == 0)
+		count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), (pEnd - pBegin) / kMinChunkBytes);
+	std::vector<const char *> cuts = SplitChunks(pBegin, pEnd, std::max<size_t>(count, 1));
+	if (cuts.size() <= 2) {
+		Close();
+		return Compute(fileSpec);
 	}
 
-	Attach(&inFile);
-	do
-	{
-		std::string tok = GetTok();
-		if (VERBOSE) {
-			if (tok == "\n")
-				tok = "newline";
-			std::cout << "\n -- Token  : " << tok << "\n";
+	std::vector<ChunkJob> jobs(cuts.size() - 1);
+	for (size_t i = 0; i < jobs.size(); i++) {
+		jobs[i].pBegin = cuts[i];
+		jobs[i].pStop = cuts[i + 1];
+	}
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Parsing " << jobs.size() << " Chunks in Parallel";
+
+	std::vector<std::thread> workers;
+	for (size_t i = 1; i < jobs.size(); i++)
+		workers.push_back(std::thread(ParseChunk, &jobs[i], pBegin, pEnd, _pContext->MagicQuotes, _pContext->_timeStates, !transcoded));
+	ParseChunk(&jobs[0], pBegin, pEnd, _pContext->MagicQuotes, _pContext->_timeStates, !transcoded);
+	for (std::thread & worker : workers)
+		worker.join();
+	for (ChunkJob & job : jobs) {
+		if (job.pInvalid != nullptr) {
+			InputError(job.pInvalid, "Invalid UTF-8");
+			Close();
+			return nullptr;
+		}
+	}
+	Close();
+
+	size_t lineCount = 0;
+	for (ChunkJob & job : jobs) {
+		lineCount += job.lineCount;
+		if (!job.clean) {
+			if (VERBOSE)
+				std::cout << "\n [VERBOSE] : A Chunk Did Not Start at a Tag, Processing the File Sequentially";
+			return Compute(fileSpec);
 		}
-	} while (inFile.good());
+	}
+	_pContext->_lineCount = lineCount;
+
+	/* A Chunk's Depths are Relative to the Depth Where it Starts */
+	ParseStats & stats = _pContext->_stats;
+	long depth = 0, maxDepth = 0;
+	for (ChunkJob & job : jobs) {
+		for (unsigned i = 0; i < ParseStats::kStates; i++) {
+			stats.tokens[i] += job.stats.tokens[i];
+			stats.cycles[i] += job.stats.cycles[i];
+		}
+		stats.nodes += job.stats.nodes;
+		stats.bytesAllocated += job.stats.bytesAllocated;
+		maxDepth = std::max(maxDepth, depth + job.maxDepth);
+		depth += job.depth;
+	}
+	stats.bytes = pEnd - pBegin;
+	stats.maxDepth = maxDepth;
+	stats.timed = _pContext->_timeStates;
+
+	DocumentBuilder builder(VERBOSE);
+	builder.SetTagIndex(_tagIndex);
+	for (ChunkJob & job : jobs)
+		job.builder.Stitch(builder);
 	if (VERBOSE)
-		std::cout << "\n Line Count : " << CurrentLineCount();
-	return _pContext->xDoc;
+		std::cout << "\n Line Count : " << lineCount;
+	XMLDocument * xDoc = builder.Release();
+	if (transcoded) {
+		std::string encoding = "UTF-8";
+		xDoc->setEncoding(encoding);
+	}
+	return xDoc;
+}
+
+/** Function to Generate a XML Document With the Reading, Tokenizing and
+  * Building Overlapped on Three Threads (See Pipelined Parsing Above) :
+  * While One Block of the File is Being Read, the Previous One is
+  * Tokenized and the Records of the One Before are Turned Into Nodes.
+  * The Result is the Same as Compute. readDepth Blocks (2 : Double
+  * Buffered) and tokenDepth Batches are in Flight at Most. Meant For
+  * Input Which is Slow to Read (e.g. on a Network Share); the File is
+  * Read, Not Memory Mapped. A Compressed File is Decompressed by the
+  * Reader Thread. Always Uses the Table Driven Engine and Decodes Values
+  * Right Away (Like Feed). Returns nullptr if the File Cannot be Opened,
+  * its Compressed Data is Corrupt or its Text is Not Valid in its Encoding.
+  *
+  * Dependant Function(s) - OpenBlockReader, ReadBlocks, TokenizeBlocks,
+  *							BuildBatch, DocumentBuilder::Release
+  *
+  * Ver : 1.3
+  *		- Builds the Tag Index When SetTagIndex Asked For it.
+  * Ver : 1.2
+  *		- Fails on Encoding Errors (Found by Feed).
+  * Ver : 1.1
+  *		- Reads Compressed Files (the Reader Thread Decompresses).
+  * Ver : 1.0
+  *		- First Release.
+  */
+XMLDocument * Toker::ComputePipelined(std::string fileSpec, size_t readDepth, size_t tokenDepth) {
+	_error = ParseError();
+	BlockReader * pIn = OpenBlockReader(fileSpec, _error.message);
+	if (pIn == nullptr)
+		return nullptr;
+	readDepth = std::max<size_t>(readDepth, 1);
+	tokenDepth = std::max<size_t>(tokenDepth, 1);
+
+	std::vector<ReadBlock> blocks(readDepth);
+	SpscRing<ReadBlock *> fullBlocks(readDepth), emptyBlocks(readDepth);
+	for (ReadBlock & block : blocks) {
+		block.data.resize(kReadBlockBytes);
+		emptyBlocks.Push(&block);
+	}
+	std::vector<TokenBatch> batches(tokenDepth);
+	SpscRing<TokenBatch *> fullBatches(tokenDepth), emptyBatches(tokenDepth);
+	for (TokenBatch & batch : batches) {
+		batch.records.reserve(kBatchRecords);
+		emptyBatches.Push(&batch);
+	}
+	if (VERBOSE)
+		std::cout << "\n [VERBOSE] : Pipelined Parse, " << readDepth << " Read Blocks, " << tokenDepth << " Token Batches";
+
+	BatchWriter writer(fullBatches, emptyBatches);
+	std::thread reader(ReadBlocks, pIn, &fullBlocks, &emptyBlocks);
+	std::thread tokenizer(TokenizeBlocks, this, &writer, &fullBlocks, &emptyBlocks);
+
+	DocumentBuilder builder(VERBOSE);
+	builder.SetTagIndex(_tagIndex);
+	while (true) {
+		TokenBatch * pBatch = fullBatches.Pop();
+		BuildBatch(*pBatch, builder);
+		if (pBatch->last)
+			break;
+		pBatch->records.clear();
+		pBatch->text.clear();
+		emptyBatches.Push(pBatch);
+	}
+	reader.join();
+	tokenizer.join();
+	bool failed = pIn->Failed();
+	delete pIn;
+	if (failed) {
+		std::cout << "\n  corrupt compressed data in " << fileSpec << "\n\n ";
+		_error.message = "Corrupt Compressed Data";
+		return nullptr;
+	}
+	if (!_error.message.empty())
+		return nullptr;
+	return builder.Release();
+}
+
+/** Function to Return the Events Recorded by the Parser, Oldest First
+  * (Empty Unless Built With XML_TRACE). Events are Recorded For Every
+  * Toker in the Process.
+  *
+  * Dependant Function(s) - TraceRing::Snapshot
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+std::vector<TraceEvent> Toker::TraceEvents() {
+#ifdef XML_TRACE
+	size_t overwritten;
+	return TraceRing::Snapshot(overwritten);
+#else
+	return std::vector<TraceEvent>();
+#endif
+}
+
+/** Function to Write the Recorded Events to out, One per Line.
+  *
+  * Dependant Function(s) - TraceRing::Snapshot
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void Toker::DumpTrace(std::ostream & out) {
+#ifdef XML_TRACE
+	static const char * kinds[] = { "State", "Token", "Push", "Pop" };
+	size_t overwritten;
+	std::vector<TraceEvent> events = TraceRing::Snapshot(overwritten);
+	if (overwritten != 0)
+		out << "\n [TRACE] : " << overwritten << " Older Events Overwritten";
+	for (const TraceEvent & event : events) {
+		out << "\n [TRACE] : " << kinds[event.kind];
+		switch (event.kind) {
+		case TraceEvent::StateChange:
+			out << " = " << kStateNames[event.state] << " (Offset " << event.offset << ", Line " << event.line << ")";
+			break;
+		case TraceEvent::Token:
+			out << " of " << event.size << " Characters (Offset " << event.offset << ", Line " << event.line << ")";
+			break;
+		default:
+			out << " (Depth " << event.size << ")";
+			break;
+		}
+	}
+#else
+	out << "\n [TRACE] : Tracing is Not Compiled In (Define XML_TRACE)";
+#endif
 }
 
+/** Function to Drop Every Recorded Event (e.g. Before a Parse Which is to
+  * be Traced on its Own).
+  *
+  * Dependant Function(s) - TraceRing::Clear
+  *
+  * Ver : 1.0
+  *		- First Release.
+  */
+void Toker::ClearTrace() {
+#ifdef XML_TRACE
+	TraceRing::Clear();
+#endif
+}
 
 #ifdef TEST_TOKENIZER
 
 #include <exception>
 
 using namespace Utilities;
+
+/** ParseHandler Used to Test Toker::Parse. Counts Elements and
+  * Attributes and Prints the Tags as They are Read.
+  */
+class ElementCounter : public ParseHandler {
+public:
+	size_t elements = 0;
+	size_t attributes = 0;
+	virtual void StartElement(const StringSpan & tag) {
+		elements++;
+		std::cout << "\n Start Element : " << tag.str();
+	}
+	virtual void Attribute(const StringSpan &, const StringSpan &) {
+		attributes++;
+	}
+};
+
+/** MatchHandler Used to Test Toker::Query. Prints Each Match.
+  */
+class MatchPrinter : public MatchHandler {
+public:
+	virtual void Match(Node * element, size_t depth) {
+		std::cout << "\n Match at Depth " << depth << " : <" << element->tag << "> " << element->GetValue()
+			<< " (" << element->children.size() << " Children)";
+	}
+};
+
 /** Function to Test Toker and Associated Classes.
   * 
   * Dependant Function(s) - StringHelper::Title, Toker::Toker, 
   *							Toker::Compute, XMLDocument::ShowXMLTree
   *
+  * Ver : 3.9
+  *		- Labels the Validation Error Expected From the File (its <Node>
+  *		  Follows <Movies> at the Top Level) and Validates Well Formed
+  *		  Snippets With '>' in Attribute Values.
+  * Ver : 3.8
+  *		- Also Builds a FlatDocument With a FlatBuilder and Compares the Trees.
+  * Ver : 3.7
+  *		- Also Reads Latin-1 and UTF-16 Copies of a Small Document and Shows
+  *		  Where Invalid UTF-8 is Found.
+  * Ver : 3.6
+  *		- Also Reuses One Toker For Several Documents (and Resets it).
+  * Ver : 3.5
+  *		- Also Reads a gzip Copy of the File (XML_WITH_ZLIB Builds).
+  * Ver : 3.4
+  *		- Also Processes the File Pipelined.
+  * Ver : 3.3
+  *		- Also Runs Streaming Tag, Value and Path Queries Over the File.
+  * Ver : 3.2
+  *		- Also Builds the Projection of the File on "Movies/Actor".
+  * Ver : 3.1
+  *		- Also Validates the File and a Malformed Snippet.
+  * Ver : 3.0
+  *		- Also Shows the Parse Statistics as JSON.
+  * Ver : 2.9
+  *		- Also Dumps the Trace of a Small Document (XML_TRACE Builds).
+  * Ver : 2.8
+  *		- Also Processes the File With Lazy Values and Compares the Trees.
+  * Ver : 2.7
+  *		- Also Processes the File Contents From Memory and Compares the Trees.
+  * Ver : 2.6
+  *		- Also Feeds the File in Small Pieces and Compares the Trees.
+  * Ver : 2.5
+  *		- Also Processes the File in Parallel Chunks and Compares the Trees.
+  * Ver : 2.4
+  *		- Also Processes the File With a ParseHandler (No XMLDocument).
+  * Ver : 2.3
+  *		- Also Processes the File Using the Table Driven Engine and Compares
+  *		  Both Trees.
   * Ver : 2.0
   *		- Updated toker to be a Pointer. This Change was made since Toker
   *		  Constructor has been Updated to Account For MagicQuote Protection
@@ -833,6 +5704,217 @@ int main() {
 
 	StringHelper::Title("Display XML Document in Tree Structure");
 	xDoc->ShowXMLTree(true);
+	std::cout << "\n\n";
+
+	StringHelper::Title("Parse Statistics (JSON)");
+	std::cout << "\n " << toker->GetStats().ToJson();
+	std::cout << "\n\n";
+
+	StringHelper::Title(std::string("Processing File : \"" + fileSpec + "\" using Table Driven Engine"));
+	Toker * tableToker = new Toker(false, true);
+	tableToker->SetEngine(Toker::TableEngine);
+	XMLDocument * xDocTable = tableToker->Compute(fileSpec);
+	if (xDocTable != nullptr && xDocTable->ShowXMLTree() == xDoc->ShowXMLTree())
+		std::cout << "\n Table Driven Engine Generated the Same XML Document";
+	else
+		std::cout << "\n [Error] : Table Driven Engine Generated a Different XML Document";
+	std::cout << "\n\n";
+
+	StringHelper::Title(std::string("Processing File : \"" + fileSpec + "\" With a ParseHandler"));
+	Toker * saxToker = new Toker(false, true);
+	ElementCounter counter;
+	saxToker->Parse(fileSpec, &counter);
+	std::cout << "\n Elements : " << counter.elements << ", Attributes : " << counter.attributes;
+	std::cout << "\n\n";
+
+	StringHelper::Title(std::string("Processing File : \"" + fileSpec + "\" Into a FlatDocument"));
+	FlatBuilder flatBuilder;
+	saxToker->Parse(fileSpec, &flatBuilder);
+	FlatDocument * flatDoc = flatBuilder.Release();
+	XMLDocument * xDocFlat = flatDoc->ToXMLDocument();
+	if (xDocFlat->ShowXMLTree() == xDoc->ShowXMLTree())
+		std::cout << "\n FlatBuilder Generated the Same XML Document (" << flatDoc->getNodeCount() << " Nodes in "
+			<< flatDoc->MemoryUsage() << " Bytes)";
+	else
+		std::cout << "\n [Error] : FlatBuilder Generated a Different XML Document";
+	std::cout << "\n Actor Elements : " << flatDoc->getElementByTag("Actor").size() << " (Names Interned : "
+		<< flatDoc->getSymbols()->Count() << ")";
+	delete xDocFlat;
+	delete flatDoc;
+	std::cout << "\n\n";
+
+	StringHelper::Title(std::string("Processing File : \"" + fileSpec + "\" in 4 Parallel Chunks"));
+	Toker * parallelToker = new Toker(false, true);
+	XMLDocument * xDocParallel = parallelToker->ComputeParallel(fileSpec, 4);
+	if (xDocParallel != nullptr && xDocParallel->ShowXMLTree() == xDoc->ShowXMLTree())
+		std::cout << "\n Parallel Chunks Generated the Same XML Document";
+	else
+		std::cout << "\n [Error] : Parallel Chunks Generated a Different XML Document";
+	std::cout << "\n\n";
+
+	StringHelper::Title(std::string("Processing File : \"" + fileSpec + "\" Pipelined"));
+	Toker * pipeToker = new Toker(false, true);
+	XMLDocument * xDocPipelined = pipeToker->ComputePipelined(fileSpec);
+	if (xDocPipelined != nullptr && xDocPipelined->ShowXMLTree() == xDoc->ShowXMLTree())
+		std::cout << "\n Pipelined Stages Generated the Same XML Document";
+	else
+		std::cout << "\n [Error] : Pipelined Stages Generated a Different XML Document";
+	std::cout << "\n\n";
+
+#ifdef XML_WITH_ZLIB
+	StringHelper::Title(std::string("Processing a gzip Copy of File : \"" + fileSpec + "\""));
+	std::ifstream plainFile(fileSpec, std::ios::binary);
+	std::string plain((std::istreambuf_iterator<char>(plainFile)), std::istreambuf_iterator<char>());
+	gzFile gzOut = gzopen((fileSpec + ".gz").c_str(), "wb");
+	gzwrite(gzOut, plain.data(), (unsigned)plain.size());
+	gzclose(gzOut);
+	Toker * gzToker = new Toker(false, true);
+	XMLDocument * xDocGzip = gzToker->Compute(fileSpec + ".gz");
+	if (xDocGzip != nullptr && xDocGzip->ShowXMLTree() == xDoc->ShowXMLTree())
+		std::cout << "\n gzip Input Generated the Same XML Document";
+	else
+		std::cout << "\n [Error] : gzip Input Generated a Different XML Document";
+	std::remove((fileSpec + ".gz").c_str());
+	std::cout << "\n\n";
+#endif
+
+	StringHelper::Title(std::string("Feeding File : \"" + fileSpec + "\" in 7 Byte Pieces"));
+	std::ifstream inFile(fileSpec, std::ios::binary);
+	std::string content((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+	Toker * pushToker = new Toker(false, true);
+	DocumentBuilder builder;
+	pushToker->Begin(&builder);
+	for (size_t pos = 0; pos < content.size(); pos += 7)
+		pushToker->Feed(content.data() + pos, std::min<size_t>(7, content.size() - pos));
+	pushToker->Finish();
+	XMLDocument * xDocPushed = builder.Release();
+	if (xDocPushed != nullptr && xDocPushed->ShowXMLTree() == xDoc->ShowXMLTree())
+		std::cout << "\n Feeding Pieces Generated the Same XML Document";
+	else
+		std::cout << "\n [Error] : Feeding Pieces Generated a Different XML Document";
+	std::cout << "\n\n";
+
+	StringHelper::Title(std::string("Processing Contents of \"" + fileSpec + "\" From Memory"));
+	Toker * memToker = new Toker(false, true);
+	XMLDocument * xDocMemory = memToker->Compute(content.data(), content.size());
+	if (xDocMemory != nullptr && xDocMemory->ShowXMLTree() == xDoc->ShowXMLTree())
+		std::cout << "\n Processing From Memory Generated the Same XML Document";
+	else
+		std::cout << "\n [Error] : Processing From Memory Generated a Different XML Document";
+	std::cout << "\n\n";
+
+	StringHelper::Title(std::string("Processing File : \"" + fileSpec + "\" With Lazy Values"));
+	Toker * lazyToker = new Toker(false, true);
+	lazyToker->SetLazyValues(true);
+	XMLDocument * xDocLazy = lazyToker->Compute(fileSpec);
+	if (xDocLazy != nullptr && xDocLazy->ShowXMLTree() == xDoc->ShowXMLTree())
+		std::cout << "\n Lazy Values Generated the Same XML Document";
+	else
+		std::cout << "\n [Error] : Lazy Values Generated a Different XML Document";
+	std::cout << "\n\n";
+
+	StringHelper::Title("Tracing a Small Document");
+	const std::string small = "<?xml version=\"1.0\"?><a><b>text</b></a>";
+	Toker * traceToker = new Toker(false, true);
+	Toker::ClearTrace();
+	XMLDocument * xDocSmall = traceToker->Compute(small.data(), small.size());
+	Toker::DumpTrace(std::cout);
+	delete xDocSmall;
+	std::cout << "\n\n";
+
+	StringHelper::Title(std::string("Validating File : \"" + fileSpec + "\""));
+	Toker * validToker = new Toker(false, true);
+	/* The File Has Two Top Level Elements (<Movies> and <Node>) on Purpose */
+	if (validToker->Validate(fileSpec))
+		std::cout << "\n [Error] : Two Root Elements Were Accepted";
+	else
+		std::cout << "\n Expected Error : " << validToker->GetError().line << ":"
+			<< validToker->GetError().column << " " << validToker->GetError().message;
+	const std::vector<std::string> wellFormed = { "<a>\n  <b/></a>\n", "<a b=\"x>y\">t</a>", "<a b='x>y'/>" };
+	for (const std::string & snippet : wellFormed) {
+		if (validToker->Validate(snippet.data(), snippet.size()))
+			std::cout << "\n Well Formed Snippet";
+		else
+			std::cout << "\n [Error] : " << validToker->GetError().message;
+	}
+	const std::string broken = "<a>\n  <b></a>";
+	if (!validToker->Validate(broken.data(), broken.size()))
+		std::cout << "\n Malformed Snippet : " << validToker->GetError().line << ":"
+			<< validToker->GetError().column << " " << validToker->GetError().message;
+	std::cout << "\n\n";
+
+	StringHelper::Title(std::string("Projecting File : \"" + fileSpec + "\" on Movies/Actor"));
+	Toker * projToker = new Toker(false, true);
+	projToker->SetProjection(std::vector<std::string>(1, "Movies/Actor"));
+	XMLDocument * xDocProjected = projToker->Compute(fileSpec);
+	if (xDocProjected != nullptr)
+		std::cout << xDocProjected->ShowXMLTree();
+	std::cout << "\n\n";
+
+	StringHelper::Title(std::string("Streaming Queries Over File : \"" + fileSpec + "\""));
+	MatchPrinter printer;
+	Toker * queryToker = new Toker(false, true);
+	QueryMatcher byTag(QueryMatcher::Tag, "Actor", &printer);
+	queryToker->Query(fileSpec, &byTag);
+	QueryMatcher byValue(QueryMatcher::Value, "May 17, 1980", &printer);
+	queryToker->Query(fileSpec, &byValue);
+	QueryMatcher byPath(QueryMatcher::Path, "Movies", &printer, true);
+	queryToker->Query(fileSpec, &byPath);
+	std::cout << "\n Matches : " << byTag.Matches() << " + " << byValue.Matches() << " + " << byPath.Matches();
+	std::cout << "\n\n";
+
+	StringHelper::Title("Reusing One Toker For Many Small Documents");
+	Toker * freshToker = new Toker(false, true);
+	XMLDocument * xDocFresh = freshToker->Compute(small.data(), small.size());
+	Toker * reusedToker = new Toker(false, true);
+	bool same = xDocFresh != nullptr;
+	for (int round = 0; round < 3 && same; round++) {
+		XMLDocument * xDocRound = reusedToker->Compute(small.data(), small.size());
+		same = xDocRound != nullptr && xDocRound->ShowXMLTree() == xDocFresh->ShowXMLTree();
+		delete xDocRound;
+	}
+	ParseHandler ignored;
+	reusedToker->Begin(&ignored);
+	reusedToker->Feed(small.data(), small.size() / 2);
+	reusedToker->Reset();
+	XMLDocument * xDocAfterReset = reusedToker->Compute(small.data(), small.size());
+	if (same && xDocAfterReset != nullptr && xDocAfterReset->ShowXMLTree() == xDocFresh->ShowXMLTree())
+		std::cout << "\n Reused Toker Generated the Same XML Document Every Time (Also After Reset)";
+	else
+		std::cout << "\n [Error] : Reused Toker Generated a Different XML Document";
+	delete xDocAfterReset;
+	delete xDocFresh;
+	delete reusedToker;
+	delete freshToker;
+	std::cout << "\n\n";
+
+	StringHelper::Title("Reading Documents in Other Encodings");
+	const std::string utf8 = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<a b=\"caf\xC3\xA9\">na\xC3\xAFve</a>";
+	const std::string latin1 = "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>\n<a b=\"caf\xE9\">na\xEFve</a>";
+	std::string utf16 = "\xFF\xFE";
+	for (size_t i = 0; i < utf8.size(); i++) {
+		unsigned char ch = (unsigned char)utf8[i];
+		unsigned long code = ch < 0x80 ? ch : (ch & 0x1F) << 6 | (utf8[++i] & 0x3F);
+		utf16.push_back((char)(code & 0xFF));
+		utf16.push_back((char)(code >> 8));
+	}
+	Toker * encodingToker = new Toker();
+	XMLDocument * xDocUtf8 = encodingToker->Compute(utf8.data(), utf8.size());
+	XMLDocument * xDocLatin1 = encodingToker->Compute(latin1.data(), latin1.size());
+	XMLDocument * xDocUtf16 = encodingToker->Compute(utf16.data(), utf16.size());
+	if (xDocLatin1 != nullptr && xDocUtf16 != nullptr &&
+		xDocLatin1->ShowXMLTree() == xDocUtf8->ShowXMLTree() && xDocUtf16->ShowXMLTree() == xDocUtf8->ShowXMLTree())
+		std::cout << "\n Latin-1 and UTF-16 Copies Generated the Same XML Document (Encoding " << xDocLatin1->getEncoding() << ")";
+	else
+		std::cout << "\n [Error] : Latin-1 / UTF-16 Copies Generated a Different XML Document";
+	const std::string invalid = "<?xml version=\"1.0\"?>\n<a>\n  na\xEFve</a>";
+	if (encodingToker->Compute(invalid.data(), invalid.size()) == nullptr)
+		std::cout << "\n Invalid UTF-8 : " << encodingToker->GetError().line << ":"
+			<< encodingToker->GetError().column << " " << encodingToker->GetError().message;
+	delete xDocUtf16;
+	delete xDocLatin1;
+	delete xDocUtf8;
+	delete encodingToker;
 	std::cout << "\n\n\n ";
 
 	return 0;
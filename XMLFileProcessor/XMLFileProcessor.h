@@ -1,7 +1,7 @@
 //////////////////////////////////////////////////////////////////////////
 // XMFileProcessor.h	:	Reads XML File Stream and Creates an XML	//
 //							Document.									//
-// Version				:	2.0											//
+// Version				:	3.14										//
 // -------------------------------------------------------------------- //
 // Copyright  Venkata Chekuri, 2016									//
 // All rights granted provided that this notice is retained.			//
@@ -20,13 +20,34 @@
 /*
  * PACKAGE OPERATIONS
  * ------------------
- * This package Provides a public Toker class, private State class and
- * a Struct Context.
+ * This package Provides a public Toker class, public ParseHandler interface,
+ * public DocumentBuilder class, private State class and a Struct Context.
  * 
  * The Toker Reads words from std::stream sequentially and Performs 
  * operations depending on the Squence of Tokens it has Read. The Objective
  * of This Toker is to Read an XML File and Convert it into XMLDocument.
  *
+ * The Toker Reports What it Reads (Start Element, Attribute, Text, End
+ * Element) to a ParseHandler. DocumentBuilder is the ParseHandler Which
+ * Builds the XMLDocument Returned by Toker::Compute; Toker::Parse Takes Any
+ * Other ParseHandler so a File Can be Processed Without Building a Tree.
+ * Input Which is Not in a File Can be Handed Over in Pieces With
+ * Toker::Begin, Toker::Feed and Toker::Finish. FlatBuilder is the
+ * ParseHandler Which Builds a FlatDocument Instead.
+ *
+ * QueryMatcher is a ParseHandler Which Answers a Query (Elements With a
+ * Given Tag, Value or Path) While the File is Read, So Files Too Large to
+ * Load Can be Searched (Toker::Query).
+ *
+ * Toker::SetProjection Restricts Compute and Parse to the Elements Under
+ * Given Paths; Everything Else is Skipped Without Being Read Into Tokens.
+ *
+ * Builds Defining XML_TRACE Record What the Parser Does (TraceEvent) in a
+ * Ring Buffer Which Can be Read or Dumped After a Parse.
+ *
+ * Input May be UTF-8 (Validated), Latin-1, Windows-1252 or UTF-16; Anything
+ * But UTF-8 is Transcoded to UTF-8 Before it is Scanned.
+ *
  * DEPENDANT FILES
  * ---------------
  * XMFileProcessor.h, XMFileProcessor.cpp, XMLDocument.h,
@@ -34,6 +55,152 @@
  *
  * CHANGELOG
  * ---------
+ * Ver 3.14 : 10/18/2026
+ *	- Numeric Character References to Surrogate Code Points (&#xD800; to
+ *	  &#xDFFF;) are Left as Text Like Other Invalid References, Rather Than
+ *	  Decoded to Invalid UTF-8.
+ *	- Toker::Validate Rejects a Second Root Element and Text After the Root
+ *	  Element, and Reads a '>' Inside a Quoted Attribute Value as Text.
+ *	- Toker::Validate Checks gzip / zstd Files Too, a Decompressed Block at
+ *	  a Time (Fed Input is Validated as it Arrives).
+ *	- The Magic Quotes Table and Decoder Live in MagicQuoteDecoder, Built Once
+ *	  and Shared by Every Context and by Lazy Values (Which Held a Context).
+ *	- Toker::Feed No Longer Searches a Token Cut by the End of a Piece From
+ *	  its Start Again With Every Piece : the Search Resumes Where it Stopped,
+ *	  so a Large Token Fed in Small Pieces Takes Linear Time.
+ *	- Toker::ComputeParallel No Longer Validates the Whole File's UTF-8 on
+ *	  One Thread Before Splitting it : Each Chunk Validates its Own Range.
+ *
+ * Ver 3.13 : 10/18/2026
+ *	- Added Toker::SetTagIndex : Documents Built by Compute, ComputeParallel
+ *	  and ComputePipelined Come With the XMLDocument Tag Index, Kept Up to
+ *	  Date Node by Node While They are Built.
+ *
+ * Ver 3.12 : 10/18/2026
+ *	- A FlatBuilder Can be Given a SymbolTable, Shared by Every FlatDocument
+ *	  it Builds (so Their Tag Names are Kept Once and Have the Same Ids).
+ *
+ * Ver 3.11 : 10/18/2026
+ *	- Added FlatBuilder : Toker::Parse Builds a FlatDocument (Nodes in One
+ *	  Array, Text in One Heap) Without Making a Node Per Element.
+ *
+ * Ver 3.10 : 10/18/2026
+ *	- Input is Checked to be Valid in its Encoding Before it is Scanned :
+ *	  UTF-8 (Told by a Byte Order Mark, or the Declaration, or the Default)
+ *	  is Validated With SSE2 / AVX2 Kernels; Latin-1, Windows-1252 and
+ *	  UTF-16 (With or Without a Byte Order Mark) are Transcoded to UTF-8,
+ *	  Which the XMLDocument Then Reports as its Encoding. Other Encodings
+ *	  and Invalid Text are Errors (Toker::GetError Gives the Line & Column).
+ *	  Lazy Values are Only Used For UTF-8 Input.
+ *
+ * Ver 3.9 : 10/18/2026
+ *	- A Toker Can be Reused For Any Number of Parses (Toker::Reset) : Its
+ *	  States, Lookup Tables, Input Buffer, Scratch Strings and the Scope
+ *	  Stack of its DocumentBuilder are Kept Warm, so a Parse Only Allocates
+ *	  the Nodes of the Resulting XMLDocument. Each Parse Now Starts Counting
+ *	  Lines (and Reading the Declaration) Afresh.
+ *
+ * Ver 3.8 : 10/18/2026
+ *	- Toker::GetError Also Says Why Compute / Parse Failed to Open or
+ *	  Decompress a File (Used by Persistance::ToXDocs For Per File Errors).
+ *
+ * Ver 3.7 : 10/18/2026
+ *	- gzip and zstd Compressed Files (Told by Their Magic Bytes) are Read
+ *	  Directly in Builds Defining XML_WITH_ZLIB / XML_WITH_ZSTD : They are
+ *	  Decompressed in Bounded Blocks Fed to the Toker (by the Reader Thread
+ *	  in ComputePipelined).
+ *
+ * Ver 3.6 : 10/18/2026
+ *	- Added Toker::ComputePipelined : Reading, Tokenizing and Building on
+ *	  Three Threads Connected by Bounded SPSC Rings (Double Buffered Reads,
+ *	  Batches of Compact Token Records).
+ *
+ * Ver 3.5 : 10/18/2026
+ *	- Added QueryMatcher, MatchHandler & Toker::Query : Tag, Value and
+ *	  Path Queries Evaluated While the File is Read, Which Hand Over Each
+ *	  Matching Element (Optionally With its Subtree) as Soon as it Ends.
+ *	  Memory Grows With the Depth of the Document, Not its Size.
+ *
+ * Ver 3.4 : 10/18/2026
+ *	- Added Projection (Toker::SetProjection) : Only Elements Matching One
+ *	  of a Set of Paths (e.g. "Movies/Actor") and Their Ancestors are
+ *	  Reported / Built. Other Subtrees are Skipped by Scanning For Tags
+ *	  Only, Without Lexing Them.
+ *
+ * Ver 3.3 : 10/18/2026
+ *	- Added Toker::Validate : Checks Tag Balance, Attribute Syntax and the
+ *	  XML Declaration Without Building a Tree, and Reports the First Error
+ *	  With its Line and Column (Toker::GetError).
+ *	- The AVX2 Scan Kernels Clear the Upper Register Halves Before Falling
+ *	  Back to the SSE2 Tails.
+ *
+ * Ver 3.2 : 10/18/2026
+ *	- Added Parse Statistics (Toker::GetStats) : Bytes, Tokens per State,
+ *	  Nodes, Maximum Depth, Estimated Bytes Allocated and (With
+ *	  Toker::SetStateTiming) Time Spent in Each State. ParseStats::ToJson
+ *	  Exports Them.
+ *
+ * Ver 3.1 : 10/18/2026
+ *	- Added Parser Tracing (Define XML_TRACE) : State Transitions, Tokens
+ *	  and Scope Pushes / Pops are Recorded as Binary Events in a Lock Free
+ *	  Ring Buffer (Toker::TraceEvents, Toker::DumpTrace). Without XML_TRACE
+ *	  the Trace Points Compile to Nothing. Replaces the Per Transition, Per
+ *	  Token and Per Element VERBOSE Output.
+ *
+ * Ver 3.0 : 10/18/2026
+ *	- Added Lazy Values (Toker::SetLazyValues) : Compute Leaves Text and
+ *	  Attribute Values Undecoded in the Input, Which the XMLDocument Keeps,
+ *	  and Nodes Decode Them on First Read.
+ *
+ * Ver 2.9 : 10/18/2026
+ *	- Magic Quotes are Decoded in a Single Pass, In Place, and Tokens are
+ *	  Only Copied When They Hold a Marker. The Standard Entities (&lt; &gt;
+ *	  &amp; &quot; &apos;) and Numeric Character References are Decoded
+ *	  Too When Magic Quotes Protection is Enabled.
+ *
+ * Ver 2.8 : 10/18/2026
+ *	- Open Tag Attributes are Lexed in a Single Pass Without Split. Quoted
+ *	  Values May Now Contain Whitespace (Single or Double Quotes), and Tag
+ *	  Name / Attributes are Separated by Any Whitespace.
+ *
+ * Ver 2.7 : 10/18/2026
+ *	- Added Toker::Compute & Toker::Parse Overloads Which Read XML Text
+ *	  Already in Memory (Scanned In Place, No Copy).
+ *
+ * Ver 2.6 : 10/18/2026
+ *	- Added Toker::Begin, Toker::Feed & Toker::Finish to Parse Input Which
+ *	  Arrives in Pieces (Pipes, Sockets) Without Writing it to a File.
+ *	  Tokens Split Across Pieces are Kept Until the Rest Arrives.
+ *
+ * Ver 2.5 : 10/18/2026
+ *	- Added Toker::ComputeParallel. The Input is Split at '<' Characters
+ *	  and the Chunks are Parsed on Separate Threads, Then Stitched Together
+ *	  Into One XMLDocument (Falls Back to Compute if a Split Lands Inside
+ *	  a Tag).
+ *
+ * Ver 2.4 : 10/18/2026
+ *	- Added ParseHandler Interface and Toker::Parse. States Report Events
+ *	  to the Handler Instead of Modifying the XMLDocument.
+ *	- Added DocumentBuilder (Moved Node Creation and the Scope Stack Out of
+ *	  the States and Context).
+ *
+ * Ver 2.3 : 10/18/2026
+ *	- Added Table Driven Engine (Character Class Transition Table, No
+ *	  Virtual Calls per Token). Selected With Toker::SetEngine; the State
+ *	  Classes Remain the Default Engine.
+ *
+ * Ver 2.2 : 10/18/2026
+ *	- Added SSE2/AVX2 Scanning Kernels For Finding Tag Delimiters, Value
+ *	  Ends, Whitespace Runs and Newlines. The Kernels are Picked at Runtime
+ *	  From the CPU Features (Scalar Fallback; Define XML_SCAN_SCALAR to
+ *	  Build Without Them).
+ *
+ * Ver 2.1 : 10/18/2026
+ *	- Input File is Memory Mapped and States Scan the Mapped Characters
+ *	  Directly Instead of Reading One Character at a Time From a Stream.
+ *	- Tokens are Spans Into the Input (Copied Only When They Have to be
+ *	  Rewritten).
+ *
  * Ver 2.0 : 01/10/2017
  *	- Added Compute Function.
  *	- Added Support For VERBOSE Mode.
@@ -50,7 +217,9 @@
 #define TOKENIZER_H
 
 #include <iosfwd>
+#include <stack>
 #include <string>
+#include <vector>
 #include <iostream>
 
 #include "../Utilities/Utilities.h"
@@ -61,6 +230,262 @@ namespace XMLScanner {
 	class State;
 	/* Forward Declaration */
 	struct Context;
+	/* Forward Declaration */
+	class ChunkBuilder;
+
+	/** Binary Event Recorded by the Parser When it is Built With XML_TRACE.
+	  *
+	  *		- kind   : What Happened.
+	  *		- state  : State Entered (StateChange, Same Order as the State Enum).
+	  *		- offset : Position of the Cursor in the Input (0 For Scope Events).
+	  *		- size   : Token Length (Token) or Scope Depth (PushScope, PopScope).
+	  *		- line   : Lines Read so Far (0 For Scope Events).
+	  *
+	  * Dependant Class(es) or Structure(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	struct TraceEvent {
+		enum Kind : unsigned char { StateChange, Token, PushScope, PopScope };
+		enum State : unsigned char { Headers, OpenTag, CloseTag, Whitespace, Value };
+
+		unsigned char kind;
+		unsigned char state;
+		size_t offset;
+		size_t size;
+		size_t line;
+	};
+
+	/** Counters Collected by the Toker During Each Parse (Toker::GetStats).
+	  * Per State Counters are Indexed by TraceEvent::State.
+	  *
+	  *		- bytes          : Input Bytes Read.
+	  *		- tokens         : Tokens Read by Each State.
+	  *		- nodes          : Elements Read (Nodes Created by Compute).
+	  *		- maxDepth       : Deepest Element Nesting.
+	  *		- bytesAllocated : Estimated Heap Bytes For the Parser's Buffers
+	  *		                   Plus the Nodes, Tags, Attributes and Values
+	  *		                   a DocumentBuilder Creates For the Input.
+	  *		- timed, cycles  : Time Spent in Each State When Toker::SetStateTiming
+	  *		                   is On (CPU Cycles on x86, Otherwise Nanoseconds).
+	  *
+	  * Dependant Class(es) or Structure(s) - TraceEvent
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	struct ParseStats {
+		static const unsigned kStates = 5;
+
+		ParseStats();
+		std::string ToJson() const;
+
+		size_t bytes;
+		size_t tokens[kStates];
+		size_t nodes;
+		size_t maxDepth;
+		size_t bytesAllocated;
+		bool timed;
+		unsigned long long cycles[kStates];
+	};
+
+	/** First Error Found by Toker::Validate, or Why Toker::Compute / Parse
+	  * Could Not Read a File (line 0). message is Empty if There Was None.
+	  *
+	  *		- line, column : Where the Error is (Both Start at 1, Column
+	  *		                 Counts Bytes).
+	  *		- message      : What is Wrong.
+	  *
+	  * Dependant Class(es) or Structure(s) - N/A
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	struct ParseError {
+		ParseError() : line(0), column(0) {}
+
+		size_t line;
+		size_t column;
+		std::string message;
+	};
+
+	/** Interface Which Receives What the Toker Reads, in Document Order.
+	  * Spans are Only Valid During the Call (Copy Them to Keep Them).
+	  * Text and Names are Already Magic Quote Decoded When That Protection
+	  * is Enabled. Every Method Does Nothing by Default.
+	  *
+	  *		- Declaration  : XML Header (Version & Encoding).
+	  *		- StartElement : Open Tag. Followed by Attribute for Each of its
+	  *		                 Attributes.
+	  *		- Text         : Value of the Innermost Open Element.
+	  *		- EndElement   : Close Tag (Tag Name as Written in the Close Tag).
+	  *
+	  * Dependant Class(es) or Structure(s) - StringSpan
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class ParseHandler {
+	public:
+		virtual ~ParseHandler() {}
+		virtual void Declaration(const std::string & /*version*/, const std::string & /*encoding*/) {}
+		virtual void StartElement(const Utilities::StringSpan & /*tag*/) {}
+		virtual void Attribute(const Utilities::StringSpan & /*name*/, const Utilities::StringSpan & /*value*/) {}
+		virtual void Text(const Utilities::StringSpan & /*value*/) {}
+		virtual void EndElement(const Utilities::StringSpan & /*tag*/) {}
+	};
+
+	/** ParseHandler Which Builds an XMLDocument Out of the Events. Elements
+	  * are Added Under the Innermost Open Element (Scope Stack), Text Sets the
+	  * Value of That Element and a Close Tag Which Does Not Match it Marks
+	  * the Document as Corrupt.
+	  *
+	  * Dependant Class(es) or Structure(s) - ParseHandler, XMLDocument, Node
+	  *
+	  * Ver : 1.4
+	  *		- Added SetTagIndex.
+	  * Ver : 1.3
+	  *		- Added Reset (Reused by Toker); the Scope Stack Keeps its Memory.
+	  * Ver : 1.2
+	  *		- Added SetRawSource (Lazy Values).
+	  * Ver : 1.1
+	  *		- ChunkBuilder (Toker::ComputeParallel) Stitches Subtrees Into it.
+	  * Ver : 1.0
+	  *		- First Release (Moved Out of EatOpenTag, EatValue, EatCloseTag
+	  *		  and EatHeaders).
+	  */
+	class DocumentBuilder : public ParseHandler {
+		friend class ChunkBuilder;
+	public:
+		DocumentBuilder(bool verbose = false);
+		DocumentBuilder(const DocumentBuilder&) = delete;
+		DocumentBuilder& operator=(const DocumentBuilder&) = delete;
+		~DocumentBuilder();
+
+		virtual void Declaration(const std::string & version, const std::string & encoding);
+		virtual void StartElement(const Utilities::StringSpan & tag);
+		virtual void Attribute(const Utilities::StringSpan & name, const Utilities::StringSpan & value);
+		virtual void Text(const Utilities::StringSpan & value);
+		virtual void EndElement(const Utilities::StringSpan & tag);
+
+		void SetRawSource(RawSource * source, const char * pBegin, const char * pEnd);
+		void SetTagIndex(bool indexed);
+		XMLDocument * Release();
+		void Reset();
+		bool IsCorrupt() { return isCorrupt; }
+	private:
+		XMLDocument * xDoc;
+		std::stack<Node *, std::vector<Node *>> _scope;
+		RawSource * _pSource;
+		const char * _pRawBegin;
+		const char * _pRawEnd;
+		bool _tagIndex;
+		bool isCorrupt;
+		bool VERBOSE;
+	};
+
+	/** ParseHandler Which Builds a FlatDocument Out of the Events (Use it With
+	  * Toker::Parse). Elements are Added Under the Innermost Open Element in
+	  * Document Order, Just as DocumentBuilder Adds Nodes; a Close Tag Which
+	  * Does Not Match it (or a Document Too Large For the FlatDocument's 32
+	  * Bit Offsets) Marks the Document as Corrupt. Names are Interned in the
+	  * SymbolTable Given to the Constructor (Shared by Every Document Built),
+	  * or One Per Document When it is Null.
+	  *
+	  * Dependant Class(es) or Structure(s) - ParseHandler, FlatDocument,
+	  *		SymbolTable
+	  *
+	  * Ver : 1.1
+	  *		- Takes a SymbolTable to Share.
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class FlatBuilder : public ParseHandler {
+	public:
+		FlatBuilder(std::shared_ptr<SymbolTable> symbols = nullptr);
+		FlatBuilder(const FlatBuilder&) = delete;
+		FlatBuilder& operator=(const FlatBuilder&) = delete;
+		~FlatBuilder();
+
+		virtual void Declaration(const std::string & version, const std::string & encoding);
+		virtual void StartElement(const Utilities::StringSpan & tag);
+		virtual void Attribute(const Utilities::StringSpan & name, const Utilities::StringSpan & value);
+		virtual void Text(const Utilities::StringSpan & value);
+		virtual void EndElement(const Utilities::StringSpan & tag);
+
+		FlatDocument * Release();
+		void Reset();
+		bool IsCorrupt() { return isCorrupt || (flatDoc != nullptr && flatDoc->IsFull()); }
+	private:
+		FlatDocument * flatDoc;
+		std::shared_ptr<SymbolTable> _symbols;
+		bool isCorrupt;
+	};
+
+	/** Interface Which Receives the Elements a QueryMatcher Finds, Each
+	  * One as Soon as its Close Tag is Read. element (and its Children) is
+	  * Owned by the QueryMatcher and Only Valid During the Call (Copy What
+	  * Has to be Kept). depth is 1 For Top Level Elements.
+	  *
+	  * Dependant Class(es) or Structure(s) - Node
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class MatchHandler {
+	public:
+		virtual ~MatchHandler() {}
+		virtual void Match(Node * element, size_t depth) = 0;
+	};
+
+	/** ParseHandler Which Evaluates a Query While the Input is Read (See
+	  * Toker::Query) and Hands the Matching Elements to a MatchHandler :
+	  *		- Tag   : Elements With the Tag (Like XMLDocument::getElementByTag).
+	  *		- Value : Elements With the Value (Like XMLDocument::getElementByValue).
+	  *		- Path  : Elements at the Path, Written Like a Toker::SetProjection
+	  *		          Path ("Movies/Actor", "*" For Any Tag).
+	  * Only the Open Elements are Kept (One Node per Level, Reused), so Memory
+	  * Grows With the Depth of the Document. With subtrees the Element is
+	  * Handed Over With Everything Inside it; Value Queries Never Include
+	  * Children (Every Open Element Would Have to be Kept Until its Value is
+	  * Known).
+	  *
+	  * Dependant Class(es) or Structure(s) - ParseHandler, MatchHandler, Node
+	  *
+	  * Ver : 1.0
+	  *		- First Release.
+	  */
+	class QueryMatcher : public ParseHandler {
+	public:
+		enum Kind { Tag, Value, Path };
+
+		QueryMatcher(Kind kind, const std::string & query, MatchHandler * handler, bool subtrees = false);
+		QueryMatcher(const QueryMatcher&) = delete;
+		QueryMatcher& operator=(const QueryMatcher&) = delete;
+		~QueryMatcher();
+
+		virtual void StartElement(const Utilities::StringSpan & tag);
+		virtual void Attribute(const Utilities::StringSpan & name, const Utilities::StringSpan & value);
+		virtual void Text(const Utilities::StringSpan & value);
+		virtual void EndElement(const Utilities::StringSpan & tag);
+
+		Kind GetKind() const { return _kind; }
+		const std::string & GetQuery() const { return _query; }
+		size_t Matches() const { return _matches; }
+	private:
+		Kind _kind;
+		std::string _query;
+		std::vector<std::string> _steps;
+		MatchHandler * _pHandler;
+		bool _subtrees;
+		std::vector<Node *> _open;
+		std::vector<Node *> _levels;
+		std::vector<bool> _matched;
+		size_t _pathDepth;
+		size_t _building;
+		size_t _matches;
+	};
 
 	/** Class Which Will Read An XML File Token By Token to
 	  * Generate an XML Document. 
@@ -70,6 +495,46 @@ namespace XMLScanner {
 	  *
 	  * Dependant Class(es) or Structure(s) - State, Context, XMLDocument
 	  *
+	  * Ver : 3.12
+	  *		- Validate Reads Compressed Files (ValidateCompressed).
+	  * Ver : 3.11
+	  *		- Added SetTagIndex.
+	  * Ver : 3.10
+	  *		- Validates UTF-8 / Transcodes Other Encodings (AttachInput,
+	  *		  FeedInput, InputError).
+	  * Ver : 3.9
+	  *		- Added Reset; Compute Reuses One DocumentBuilder (_pBuilder).
+	  * Ver : 3.8
+	  *		- GetError Reports Why a File Could Not be Read.
+	  * Ver : 3.7
+	  *		- Compute, Parse, Query & ComputePipelined Read Compressed Files.
+	  * Ver : 3.6
+	  *		- Added ComputePipelined (Read / Tokenize / Build Threads).
+	  * Ver : 3.5
+	  *		- Added Query (Streaming QueryMatcher).
+	  * Ver : 3.4
+	  *		- Added SetProjection.
+	  * Ver : 3.3
+	  *		- Added Validate & GetError.
+	  * Ver : 3.2
+	  *		- Added GetStats & SetStateTiming.
+	  * Ver : 3.1
+	  *		- Added TraceEvents, DumpTrace & ClearTrace (XML_TRACE Builds).
+	  * Ver : 3.0
+	  *		- Added SetLazyValues.
+	  * Ver : 2.7
+	  *		- Added Compute & Parse Overloads For Text Already in Memory.
+	  * Ver : 2.6
+	  *		- Added Begin, Feed & Finish (Input Handed Over in Pieces).
+	  * Ver : 2.5
+	  *		- Added ComputeParallel (Chunks Parsed by Several Threads).
+	  * Ver : 2.4
+	  *		- Added Parse (Events to a ParseHandler, No XMLDocument).
+	  *		- Compute Builds the XMLDocument Through a DocumentBuilder.
+	  * Ver : 2.3
+	  *		- Added Engine Selection (SetEngine).
+	  * Ver : 2.1
+	  *		- Compute Memory Maps the Input File.
 	  * Ver : 2.0
 	  *		- Added Compute Function.
 	  *		- Added Support for VERBOSE Mode.
@@ -78,20 +543,64 @@ namespace XMLScanner {
 	  */
 	class Toker {
 	public:
+		enum Engine { StateEngine, TableEngine };
+
 		Toker(bool verbose = false, bool MagicQuotes = false);
 		Toker(const Toker&) = delete;
 		~Toker();
 		Toker& operator=(const Toker&) = delete;
 		bool Attach(std::istream* pIn);
 		XMLDocument * Compute(std::string fileSpec);
+		XMLDocument * Compute(const char * data, size_t length);
+		XMLDocument * ComputeParallel(std::string fileSpec, unsigned threads = 0);
+		XMLDocument * ComputePipelined(std::string fileSpec, size_t readDepth = 2, size_t tokenDepth = 8);
+		bool Parse(std::string fileSpec, ParseHandler * handler);
+		bool Parse(const char * data, size_t length, ParseHandler * handler);
+		bool Query(std::string fileSpec, QueryMatcher * matcher);
+		bool Begin(ParseHandler * handler);
+		bool Feed(const char * data, size_t length);
+		bool Finish();
+		bool Validate(std::string fileSpec);
+		bool Validate(const char * data, size_t length);
+		const ParseError & GetError() const;
+		void SetEngine(Engine engine);
+		void SetLazyValues(bool lazy);
+		void SetTagIndex(bool indexed);
+		void SetStateTiming(bool timing);
+		void SetProjection(const std::vector<std::string> & paths);
+		const ParseStats & GetStats() const;
+		void Reset(bool releaseBuffers = false);
+
+		static std::vector<TraceEvent> TraceEvents();
+		static void DumpTrace(std::ostream & out);
+		static void ClearTrace();
 	private:
 		std::string GetTok();
+		bool NextTok();
 		bool CanRead();
 		size_t CurrentLineCount();
+		bool Open(const std::string & fileSpec);
+		void Run();
+		void Close();
+		void CollectStats();
+		bool RunValidation();
+		bool ParseCompressed(const std::string & fileSpec, ParseHandler * handler);
+		bool ValidateCompressed(const std::string & fileSpec);
+		bool AttachInput(const char * pBegin, const char * pEnd);
+		bool FeedInput(const char * data, size_t length, bool last);
+		bool InputError(const char * pAt, const std::string & message);
+		XMLDocument * ComputeLazy(RawSource * source, const char * data, size_t length);
+		DocumentBuilder & Builder();
 
 		State * _pConsumer;
 		Context * _pContext;
+		DocumentBuilder * _pBuilder;
 		std::string FilePath;
+		Engine _engine;
+		bool _lazyValues;
+		bool _tagIndex;
+		ParseError _error;
+		std::vector<std::vector<std::string>> _projection;
 
 		bool VERBOSE;
 	};